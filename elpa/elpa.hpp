@@ -0,0 +1,411 @@
+//    This file is part of ELPA.
+//
+//    The ELPA library was originally created by the ELPA consortium,
+//    consisting of the following organizations:
+//
+//    - Max Planck Computing and Data Facility (MPCDF), formerly known as
+//      Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+//    - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+//      Informatik,
+//    - Technische Universität München, Lehrstuhl für Informatik mit
+//      Schwerpunkt Wissenschaftliches Rechnen ,
+//    - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+//    - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+//      Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+//      and
+//    - IBM Deutschland GmbH
+//
+//    More information can be found here:
+//    http://elpa.mpcdf.mpg.de/
+//
+//    ELPA is free software: you can redistribute it and/or modify
+//    it under the terms of the version 3 of the license of the
+//    GNU Lesser General Public License as published by the Free
+//    Software Foundation.
+//
+//    ELPA is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with ELPA.  If not, see <http://www.gnu.org/licenses/>
+//
+//    ELPA reflects a substantial effort on the part of the original
+//    ELPA consortium, and we ask you to respect the spirit of the
+//    license that we chose: i.e., please contribute any changes you
+//    may have back to the original ELPA library distribution, and keep
+//    any derivatives of ELPA under the same license that we chose for
+//    the original distribution, the GNU Lesser General Public License.
+//
+
+/*! \file elpa.hpp
+ *  \brief header-only C++17 interface to ELPA
+ *
+ *  \details
+ *  Thin layer on top of the C API in elpa/elpa.h:
+ *  - elpa::library and elpa::solver own the library initialization and an ELPA object (RAII)
+ *  - the options in elpa::opt are typed: setting a boolean option with a double or
+ *    misspelling an option name is a compile-time error
+ *  - elpa::matrix_view describes the local part of a distributed matrix in user memory;
+ *    nothing is copied
+ *  - errors are reported as elpa::error exceptions
+ *
+ *  With C++20 the solve methods accept std::span for the eigenvalues, with C++23
+ *  std::mdspan with std::layout_left for the matrices.
+ *
+ *  \code
+ *  elpa::library lib;
+ *  elpa::solver s;
+ *  s.set(elpa::opt::na, na).set(elpa::opt::nev, nev).set(elpa::opt::nblk, nblk)
+ *   .set(elpa::opt::local_nrows, na_rows).set(elpa::opt::local_ncols, na_cols)
+ *   .set_communicator(MPI_COMM_WORLD, my_prow, my_pcol);
+ *  s.setup();
+ *  s.set(elpa::opt::solver, ELPA_SOLVER_2STAGE);
+ *  s.eigenvectors(elpa::matrix_view<double>(a, na_rows, na_cols), ev,
+ *                 elpa::matrix_view<double>(z, na_rows, na_cols));
+ *  \endcode
+ */
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+#if __cplusplus > 202002L && __has_include(<mdspan>)
+#include <mdspan>
+#endif
+
+#include <elpa/elpa.h>
+
+namespace elpa {
+
+/*! \brief exception thrown for every ELPA error code other than ELPA_OK */
+class error : public std::runtime_error {
+  public:
+    error(int code, const std::string &what)
+      : std::runtime_error("ELPA: " + what + ": " + elpa_strerr(code)), code_(code) {}
+
+    /*! \brief the ELPA error code, see elpa_constants.h */
+    int code() const noexcept { return code_; }
+
+  private:
+    int code_;
+};
+
+namespace detail {
+
+inline void check(int err, const char *what) {
+  if (err != ELPA_OK) {
+    throw error(err, what);
+  }
+}
+
+template <typename T> struct identity { using type = T; };
+template <typename T> using identity_t = typename identity<T>::type;
+
+template <typename T> struct real_of { using type = T; };
+template <typename T> struct real_of<std::complex<T>> { using type = T; };
+
+template <typename T>
+inline constexpr bool is_elpa_type_v = std::is_same_v<T, double> || std::is_same_v<T, float> ||
+                                       std::is_same_v<T, std::complex<double>> ||
+                                       std::is_same_v<T, std::complex<float>>;
+
+/* options, whose values are kept by elpa::solver for the checks of the matrix views */
+enum class option_id { other, na, local_nrows, local_ncols };
+
+} // namespace detail
+
+/*! \brief the real type of the eigenvalues for a matrix of type T */
+template <typename T> using real_t = typename detail::real_of<T>::type;
+
+/*! \brief a typed ELPA option; T is int, bool or double */
+template <typename T>
+struct option {
+  static_assert(std::is_same_v<T, int> || std::is_same_v<T, bool> || std::is_same_v<T, double>,
+                "ELPA options are of type int, bool or double");
+  const char *name;
+  detail::option_id id = detail::option_id::other;
+};
+
+/*! \brief the ELPA options; see elpa_set(3) and the output of elpa_print_settings */
+namespace opt {
+// matrix and distribution
+inline constexpr option<int> na{"na", detail::option_id::na};
+inline constexpr option<int> nev{"nev"};
+inline constexpr option<int> nblk{"nblk"};
+inline constexpr option<int> local_nrows{"local_nrows", detail::option_id::local_nrows};
+inline constexpr option<int> local_ncols{"local_ncols", detail::option_id::local_ncols};
+inline constexpr option<int> mpi_comm_parent{"mpi_comm_parent"};
+inline constexpr option<int> mpi_comm_rows{"mpi_comm_rows"};
+inline constexpr option<int> mpi_comm_cols{"mpi_comm_cols"};
+inline constexpr option<int> process_row{"process_row"};
+inline constexpr option<int> process_col{"process_col"};
+inline constexpr option<int> blacs_context{"blacs_context"};
+inline constexpr option<int> bandwidth{"bandwidth"};
+inline constexpr option<int> matrix_order{"matrix_order"};
+// solver and kernels
+inline constexpr option<int> solver{"solver"};
+inline constexpr option<int> real_kernel{"real_kernel"};
+inline constexpr option<int> complex_kernel{"complex_kernel"};
+inline constexpr option<bool> qr{"qr"};
+inline constexpr option<int> omp_threads{"omp_threads"};
+inline constexpr option<int> intermediate_bandwidth{"intermediate_bandwidth"};
+inline constexpr option<int> stripewidth_real{"stripewidth_real"};
+inline constexpr option<int> stripewidth_complex{"stripewidth_complex"};
+inline constexpr option<bool> sterf_for_eigenvalues_only{"sterf_for_eigenvalues_only"};
+inline constexpr option<bool> store_householder{"store_householder"};
+inline constexpr option<bool> dc_fmm{"dc_fmm"};
+inline constexpr option<int> dc_fmm_min_size{"dc_fmm_min_size"};
+inline constexpr option<double> dc_fmm_tolerance{"dc_fmm_tolerance"};
+inline constexpr option<bool> merge_systems_overlap{"merge_systems_overlap"};
+inline constexpr option<int> merge_systems_slice{"merge_systems_slice"};
+inline constexpr option<int> solve_tridi_leaf_size{"solve_tridi_leaf_size"};
+inline constexpr option<int> max_stored_rows{"max_stored_rows"};
+inline constexpr option<bool> trans_ev_lookahead{"trans_ev_lookahead"};
+inline constexpr option<int> back_transform_chunk{"back_transform_chunk"};
+inline constexpr option<bool> kernel_model{"kernel_model"};
+// GPUs
+inline constexpr option<int> nvidia_gpu{"nvidia-gpu"};
+inline constexpr option<int> amd_gpu{"amd-gpu"};
+inline constexpr option<int> intel_gpu{"intel-gpu"};
+inline constexpr option<int> use_gpu_id{"use_gpu_id"};
+// generalized problems and Cholesky
+inline constexpr option<bool> cannon_for_generalized{"cannon_for_generalized"};
+inline constexpr option<bool> pxtrmm_for_generalized{"pxtrmm_for_generalized"};
+inline constexpr option<bool> generalized_fused{"generalized_fused"};
+inline constexpr option<bool> invert_trm_recursive{"invert_trm_recursive"};
+inline constexpr option<bool> check_pd{"check_pd"};
+inline constexpr option<double> thres_pd_double{"thres_pd_double"};
+// diagnostics
+inline constexpr option<bool> timings{"timings"};
+inline constexpr option<bool> measure_memory{"measure_memory"};
+inline constexpr option<bool> trace{"trace"};
+inline constexpr option<bool> debug{"debug"};
+inline constexpr option<int> verbose{"verbose"};
+} // namespace opt
+
+/*! \brief non-owning view of the local part of a block-cyclic distributed matrix
+ *
+ *  The local matrix is stored column-major with leading dimension local_nrows,
+ *  as required by ELPA.
+ */
+template <typename T>
+class matrix_view {
+    static_assert(detail::is_elpa_type_v<T>, "ELPA supports float, double and their complex types");
+
+  public:
+    matrix_view(T *data, int local_nrows, int local_ncols) noexcept
+      : data_(data), local_nrows_(local_nrows), local_ncols_(local_ncols) {}
+
+#ifdef __cpp_lib_span
+    /*! \brief view of a span, which must hold at least local_nrows*local_ncols elements */
+    matrix_view(std::span<T> data, int local_nrows, int local_ncols)
+      : matrix_view(data.data(), local_nrows, local_ncols) {
+      if (data.size() < size()) {
+        throw std::length_error("elpa::matrix_view: the span is smaller than the local matrix");
+      }
+    }
+#endif
+
+#ifdef __cpp_lib_mdspan
+    template <typename Extents>
+    matrix_view(std::mdspan<T, Extents, std::layout_left> data) noexcept
+      : matrix_view(data.data_handle(), static_cast<int>(data.extent(0)), static_cast<int>(data.extent(1))) {}
+#endif
+
+    T *data() const noexcept { return data_; }
+    int local_nrows() const noexcept { return local_nrows_; }
+    int local_ncols() const noexcept { return local_ncols_; }
+    std::size_t size() const noexcept {
+      return static_cast<std::size_t>(local_nrows_) * static_cast<std::size_t>(local_ncols_);
+    }
+
+  private:
+    T *data_;
+    int local_nrows_;
+    int local_ncols_;
+};
+
+/*! \brief initializes the library for the lifetime of the object (elpa_init/elpa_uninit) */
+class library {
+  public:
+    explicit library(int api_version = ELPA_API_VERSION) {
+      detail::check(elpa_init(api_version), "elpa_init");
+    }
+    ~library() {
+      int err;
+      elpa_uninit(&err);
+    }
+    library(const library &) = delete;
+    library &operator=(const library &) = delete;
+};
+
+/*! \brief an ELPA object (elpa_allocate/elpa_deallocate)
+ *
+ *  All methods throw elpa::error if ELPA reports an error.
+ */
+class solver {
+  public:
+    solver() {
+      int err;
+      handle_ = elpa_allocate(&err);
+      detail::check(err, "elpa_allocate");
+    }
+
+    ~solver() {
+      if (handle_ != nullptr) {
+        int err;
+        elpa_deallocate(handle_, &err);
+      }
+    }
+
+    solver(const solver &) = delete;
+    solver &operator=(const solver &) = delete;
+
+    solver(solver &&other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)), na_(other.na_),
+        local_nrows_(other.local_nrows_), local_ncols_(other.local_ncols_) {}
+
+    solver &operator=(solver &&other) noexcept {
+      std::swap(handle_, other.handle_);
+      std::swap(na_, other.na_);
+      std::swap(local_nrows_, other.local_nrows_);
+      std::swap(local_ncols_, other.local_ncols_);
+      return *this;
+    }
+
+    /*! \brief the handle for the C API */
+    elpa_t handle() const noexcept { return handle_; }
+
+    template <typename T>
+    solver &set(option<T> o, detail::identity_t<T> value) {
+      int err;
+      if constexpr (std::is_same_v<T, double>) {
+        elpa_set_double(handle_, o.name, value, &err);
+      } else {
+        elpa_set_integer(handle_, o.name, static_cast<int>(value), &err);
+      }
+      detail::check(err, std::string("setting option ").append(o.name).c_str());
+      remember(o.id, static_cast<int>(value));
+      return *this;
+    }
+
+    template <typename T>
+    T get(option<T> o) const {
+      int err;
+      if constexpr (std::is_same_v<T, double>) {
+        double value;
+        elpa_get_double(handle_, o.name, &value, &err);
+        detail::check(err, std::string("getting option ").append(o.name).c_str());
+        return value;
+      } else {
+        int value;
+        elpa_get_integer(handle_, o.name, &value, &err);
+        detail::check(err, std::string("getting option ").append(o.name).c_str());
+        return static_cast<T>(value);
+      }
+    }
+
+    /*! \brief options not listed in elpa::opt */
+    solver &set(const char *name, int value) { return set(option<int>{name}, value); }
+    solver &set(const char *name, double value) { return set(option<double>{name}, value); }
+
+#ifdef MPI_VERSION
+    /*! \brief sets the parent communicator and the position of this process in the process grid */
+    solver &set_communicator(MPI_Comm comm, int process_row, int process_col) {
+      return set(opt::mpi_comm_parent, static_cast<int>(MPI_Comm_c2f(comm)))
+            .set(opt::process_row, process_row)
+            .set(opt::process_col, process_col);
+    }
+#endif
+
+    void setup() { detail::check(elpa_setup(handle_), "elpa_setup"); }
+
+    /*! \brief eigenvalues and the first nev eigenvectors; a is overwritten */
+    template <typename T>
+    void eigenvectors(matrix_view<T> a, real_t<T> *ev, matrix_view<T> q) {
+      check_local(a, "eigenvectors");
+      check_local(q, "eigenvectors");
+      int err;
+      elpa_eigenvectors(handle_, a.data(), ev, q.data(), &err);
+      detail::check(err, "eigenvectors");
+    }
+
+    /*! \brief eigenvalues only; a is overwritten */
+    template <typename T>
+    void eigenvalues(matrix_view<T> a, real_t<T> *ev) {
+      check_local(a, "eigenvalues");
+      int err;
+      elpa_eigenvalues(handle_, a.data(), ev, &err);
+      detail::check(err, "eigenvalues");
+    }
+
+#ifdef __cpp_lib_span
+    template <typename T>
+    void eigenvectors(matrix_view<T> a, std::span<real_t<T>> ev, matrix_view<T> q) {
+      check_eigenvalues(ev.size(), "eigenvectors");
+      eigenvectors(a, ev.data(), q);
+    }
+
+    template <typename T>
+    void eigenvalues(matrix_view<T> a, std::span<real_t<T>> ev) {
+      check_eigenvalues(ev.size(), "eigenvalues");
+      eigenvalues(a, ev.data());
+    }
+#endif
+
+#ifdef __cpp_lib_mdspan
+    template <typename T, typename Extents>
+    void eigenvectors(std::mdspan<T, Extents, std::layout_left> a, std::span<real_t<T>> ev,
+                      std::mdspan<T, Extents, std::layout_left> q) {
+      eigenvectors(matrix_view<T>(a), ev, matrix_view<T>(q));
+    }
+
+    template <typename T, typename Extents>
+    void eigenvalues(std::mdspan<T, Extents, std::layout_left> a, std::span<real_t<T>> ev) {
+      eigenvalues(matrix_view<T>(a), ev);
+    }
+#endif
+
+  private:
+    void remember(detail::option_id id, int value) noexcept {
+      switch (id) {
+        case detail::option_id::na:          na_ = value; break;
+        case detail::option_id::local_nrows: local_nrows_ = value; break;
+        case detail::option_id::local_ncols: local_ncols_ = value; break;
+        default: break;
+      }
+    }
+
+    /* only options set through elpa::solver are known, -1 skips the check */
+    template <typename T>
+    void check_local(const matrix_view<T> &m, const char *what) const {
+      if ((local_nrows_ >= 0 && m.local_nrows() != local_nrows_) ||
+          (local_ncols_ >= 0 && m.local_ncols() != local_ncols_)) {
+        throw std::invalid_argument(std::string("elpa::solver::") + what +
+                                    ": the matrix view does not match local_nrows/local_ncols");
+      }
+    }
+
+    void check_eigenvalues(std::size_t n, const char *what) const {
+      if (na_ >= 0 && n < static_cast<std::size_t>(na_)) {
+        throw std::invalid_argument(std::string("elpa::solver::") + what +
+                                    ": the eigenvalue span is smaller than na");
+      }
+    }
+
+    elpa_t handle_ = nullptr;
+    int na_ = -1;
+    int local_nrows_ = -1;
+    int local_ncols_ = -1;
+};
+
+} // namespace elpa
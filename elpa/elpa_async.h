@@ -0,0 +1,63 @@
+#pragma once
+
+/* Asynchronous solves
+ *
+ * elpa_eigenvectors_async/elpa_eigenvalues_async start the solve in a helper
+ * thread and return immediately. The request is completed with elpa_test or
+ * elpa_wait, which return the error code of the solve. Until then neither the
+ * handle nor the matrices must be touched by the caller. With MPI the calls
+ * are collective and MPI must be initialized with at least
+ * MPI_THREAD_SERIALIZED; with less than MPI_THREAD_MULTIPLE the caller must not
+ * make MPI calls while the solve is running.
+ */
+
+struct elpa_request_struct;
+typedef struct elpa_request_struct *elpa_request_t;
+
+#define ELPA_REQUEST_NULL ((elpa_request_t) 0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void elpa_eigenvectors_async_a_h_a_d(elpa_t handle, double *a, double *ev, double *q, elpa_request_t *request, int *error);
+void elpa_eigenvectors_async_a_h_a_f(elpa_t handle, float *a, float *ev, float *q, elpa_request_t *request, int *error);
+void elpa_eigenvectors_async_a_h_a_dc(elpa_t handle, double_complex *a, double *ev, double_complex *q, elpa_request_t *request, int *error);
+void elpa_eigenvectors_async_a_h_a_fc(elpa_t handle, float_complex *a, float *ev, float_complex *q, elpa_request_t *request, int *error);
+
+void elpa_eigenvalues_async_a_h_a_d(elpa_t handle, double *a, double *ev, elpa_request_t *request, int *error);
+void elpa_eigenvalues_async_a_h_a_f(elpa_t handle, float *a, float *ev, elpa_request_t *request, int *error);
+void elpa_eigenvalues_async_a_h_a_dc(elpa_t handle, double_complex *a, double *ev, elpa_request_t *request, int *error);
+void elpa_eigenvalues_async_a_h_a_fc(elpa_t handle, float_complex *a, float *ev, elpa_request_t *request, int *error);
+
+/*! \brief test whether an asynchronous solve has finished
+ *
+ *  \param  request  the request; set to ELPA_REQUEST_NULL once the solve has finished
+ *  \param  flag     on return 1 if the solve has finished, 0 otherwise
+ *  \param  error    on return the error code of the solve if it has finished,
+ *                   ELPA_ERROR_CANCELLED if it was stopped by elpa_cancel
+ */
+void elpa_test(elpa_request_t *request, int *flag, int *error);
+
+/*! \brief wait until an asynchronous solve has finished
+ *
+ *  \param  request  the request; set to ELPA_REQUEST_NULL on return
+ *  \param  error    on return the error code of the solve,
+ *                   ELPA_ERROR_CANCELLED if it was stopped by elpa_cancel
+ */
+void elpa_wait(elpa_request_t *request, int *error);
+
+/*! \brief ask an asynchronous solve to stop
+ *
+ *  The solve stops at the end of the current step of the solver; the request
+ *  has still to be completed with elpa_test or elpa_wait. A solve that is past
+ *  its last step finishes normally.
+ *
+ *  \param  request  the request
+ *  \param  error    on return the error code, which can be queried with elpa_strerr()
+ */
+void elpa_cancel(elpa_request_t request, int *error);
+
+#ifdef __cplusplus
+}
+#endif
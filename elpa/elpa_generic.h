@@ -419,3 +419,250 @@ inline void elpa_solve_tridiagonal(elpa_t handle, float  *d, float  *e, float  *
                   elpa_solve_tridiagonal_f \
         )(handle, d, e, q, error)
 #endif
+
+/*! \brief generic C method for elpa_back_transform
+ *
+ *  \details
+ *  \param  handle  handle of the ELPA object, which defines the problem
+ *  \param  q       float/double float complex/double complex pointer to matrix q; on input eigenvectors of
+ *                  the tridiagonal matrix stored with the option "store_householder", on return the
+ *                  eigenvectors of the original matrix
+ *  \param  ncols   number of (global) columns of q to be transformed
+ *  \param  error   on return the error code, which can be queried with elpa_strerr()
+ *  \result void
+ */
+#ifdef __cplusplus
+inline void elpa_back_transform(elpa_t handle, double *q, int ncols, int *error)
+	{
+	elpa_back_transform_a_h_a_d(handle, q, ncols, error);
+	}
+inline void elpa_back_transform(elpa_t handle, float  *q, int ncols, int *error)
+	{
+	elpa_back_transform_a_h_a_f(handle, q, ncols, error);
+	}
+inline void elpa_back_transform(elpa_t handle, std::complex<double> *q, int ncols, int *error)
+	{
+	elpa_back_transform_a_h_a_dc(handle, q, ncols, error);
+	}
+inline void elpa_back_transform(elpa_t handle, std::complex<float>  *q, int ncols, int *error)
+	{
+	elpa_back_transform_a_h_a_fc(handle, q, ncols, error);
+	}
+#else
+#define elpa_back_transform(handle, q, ncols, error) _Generic((q), \
+                double*: \
+                  elpa_back_transform_a_h_a_d, \
+                \
+                float*: \
+                  elpa_back_transform_a_h_a_f, \
+                \
+                double complex*: \
+                  elpa_back_transform_a_h_a_dc, \
+                \
+                float complex*: \
+                  elpa_back_transform_a_h_a_fc \
+        )(handle, q, ncols, error)
+#endif
+
+/*! \brief generic C method for elpa_stored_tridiagonal
+ *
+ *  \details
+ *  \param  handle  handle of the ELPA object, which defines the problem
+ *  \param d        float/double pointer to array d; on return the diagonal elements of the tridiagonal matrix
+ *                  stored with the option "store_householder"
+ *  \param e        float/double pointer to array e; on return the subdiagonal elements of this matrix
+ *  \param  error   on return the error code, which can be queried with elpa_strerr()
+ *  \result void
+ */
+#ifdef __cplusplus
+inline void elpa_stored_tridiagonal(elpa_t handle, double *d, double *e, int *error)
+	{
+	elpa_stored_tridiagonal_d(handle, d, e, error);
+	}
+inline void elpa_stored_tridiagonal(elpa_t handle, float  *d, float  *e, int *error)
+	{
+	elpa_stored_tridiagonal_f(handle, d, e, error);
+	}
+#else
+#define elpa_stored_tridiagonal(handle, d, e, error) _Generic((d), \
+                double*: \
+                  elpa_stored_tridiagonal_d, \
+                \
+                float*: \
+                  elpa_stored_tridiagonal_f \
+        )(handle, d, e, error)
+#endif
+
+/*! \brief generic C method for elpa_read_matrix
+ *
+ *  \details
+ *  \param  handle     handle of the ELPA object, which defines the problem
+ *  \param  file_name  name of the matrix file
+ *  \param  a          float/double float complex/double complex pointer to matrix a; on return the local part of the matrix read from the file
+ *  \param  error      on return the error code, which can be queried with elpa_strerr()
+ *  \result void
+ */
+#ifdef __cplusplus
+inline void elpa_read_matrix(elpa_t handle, const char *file_name, double *a, int *error)
+	{
+	elpa_read_matrix_a_h_a_d(handle, file_name, a, error);
+	}
+inline void elpa_read_matrix(elpa_t handle, const char *file_name, float  *a, int *error)
+	{
+	elpa_read_matrix_a_h_a_f(handle, file_name, a, error);
+	}
+inline void elpa_read_matrix(elpa_t handle, const char *file_name, std::complex<double> *a, int *error)
+	{
+	elpa_read_matrix_a_h_a_dc(handle, file_name, a, error);
+	}
+inline void elpa_read_matrix(elpa_t handle, const char *file_name, std::complex<float>  *a, int *error)
+	{
+	elpa_read_matrix_a_h_a_fc(handle, file_name, a, error);
+	}
+#else
+#define elpa_read_matrix(handle, file_name, a, error) _Generic((a), \
+                double*: \
+                  elpa_read_matrix_a_h_a_d, \
+                \
+                float*: \
+                  elpa_read_matrix_a_h_a_f, \
+                \
+                double complex*: \
+                  elpa_read_matrix_a_h_a_dc, \
+                \
+                float complex*: \
+                  elpa_read_matrix_a_h_a_fc \
+        )(handle, file_name, a, error)
+#endif
+
+/*! \brief generic C method for elpa_write_matrix
+ *
+ *  \details
+ *  \param  handle     handle of the ELPA object, which defines the problem
+ *  \param  file_name  name of the matrix file
+ *  \param  a          float/double float complex/double complex pointer to matrix a; the local part of the matrix, which is written to the file
+ *  \param  error      on return the error code, which can be queried with elpa_strerr()
+ *  \result void
+ */
+#ifdef __cplusplus
+inline void elpa_write_matrix(elpa_t handle, const char *file_name, double *a, int *error)
+	{
+	elpa_write_matrix_a_h_a_d(handle, file_name, a, error);
+	}
+inline void elpa_write_matrix(elpa_t handle, const char *file_name, float  *a, int *error)
+	{
+	elpa_write_matrix_a_h_a_f(handle, file_name, a, error);
+	}
+inline void elpa_write_matrix(elpa_t handle, const char *file_name, std::complex<double> *a, int *error)
+	{
+	elpa_write_matrix_a_h_a_dc(handle, file_name, a, error);
+	}
+inline void elpa_write_matrix(elpa_t handle, const char *file_name, std::complex<float>  *a, int *error)
+	{
+	elpa_write_matrix_a_h_a_fc(handle, file_name, a, error);
+	}
+#else
+#define elpa_write_matrix(handle, file_name, a, error) _Generic((a), \
+                double*: \
+                  elpa_write_matrix_a_h_a_d, \
+                \
+                float*: \
+                  elpa_write_matrix_a_h_a_f, \
+                \
+                double complex*: \
+                  elpa_write_matrix_a_h_a_dc, \
+                \
+                float complex*: \
+                  elpa_write_matrix_a_h_a_fc \
+        )(handle, file_name, a, error)
+#endif
+
+/*! \brief generic C method for elpa_eigenvectors_async
+ *
+ *  \details
+ *  \param  handle   handle of the ELPA object, which defines the problem
+ *  \param  a        float/double float complex/double complex pointer to matrix a
+ *  \param  ev       on completion: float/double pointer to eigenvalues
+ *  \param  q        on completion: float/double float complex/double complex pointer to eigenvectors
+ *  \param  request  on return the request, which has to be completed with elpa_test() or elpa_wait()
+ *  \param  error    on return the error code, which can be queried with elpa_strerr()
+ *  \result void
+ */
+#ifdef __cplusplus
+inline void elpa_eigenvectors_async(const elpa_t handle, double *a, double *ev, double *q, elpa_request_t *request, int *error)
+	{
+	elpa_eigenvectors_async_a_h_a_d(handle, a, ev, q, request, error);
+	}
+
+inline void elpa_eigenvectors_async(const elpa_t handle, float  *a, float  *ev, float  *q, elpa_request_t *request, int *error)
+	{
+	elpa_eigenvectors_async_a_h_a_f(handle, a, ev, q, request, error);
+	}
+
+inline void elpa_eigenvectors_async(const elpa_t handle, std::complex<double> *a, double *ev, std::complex<double> *q, elpa_request_t *request, int *error)
+	{
+	elpa_eigenvectors_async_a_h_a_dc(handle, a, ev, q, request, error);
+	}
+
+inline void elpa_eigenvectors_async(const elpa_t handle, std::complex<float>  *a, float  *ev, std::complex<float>  *q, elpa_request_t *request, int *error)
+	{
+	elpa_eigenvectors_async_a_h_a_fc(handle, a, ev, q, request, error);
+	}
+#else
+#define elpa_eigenvectors_async(handle, a, ev, q, request, error) _Generic((a), \
+                double*: \
+                  elpa_eigenvectors_async_a_h_a_d, \
+                \
+                float*: \
+                  elpa_eigenvectors_async_a_h_a_f, \
+                \
+                double complex*: \
+                  elpa_eigenvectors_async_a_h_a_dc, \
+                \
+                float complex*: \
+                  elpa_eigenvectors_async_a_h_a_fc \
+        )(handle, a, ev, q, request, error)
+#endif
+
+/*! \brief generic C method for elpa_eigenvalues_async
+ *
+ *  \details
+ *  \param  handle   handle of the ELPA object, which defines the problem
+ *  \param  a        float/double float complex/double complex pointer to matrix a
+ *  \param  ev       on completion: float/double pointer to eigenvalues
+ *  \param  request  on return the request, which has to be completed with elpa_test() or elpa_wait()
+ *  \param  error    on return the error code, which can be queried with elpa_strerr()
+ *  \result void
+ */
+#ifdef __cplusplus
+inline void elpa_eigenvalues_async(elpa_t handle, double *a, double *ev, elpa_request_t *request, int *error)
+	{
+	elpa_eigenvalues_async_a_h_a_d(handle, a, ev, request, error);
+	}
+inline void elpa_eigenvalues_async(elpa_t handle, float  *a, float  *ev, elpa_request_t *request, int *error)
+	{
+	elpa_eigenvalues_async_a_h_a_f(handle, a, ev, request, error);
+	}
+inline void elpa_eigenvalues_async(elpa_t handle, std::complex<double> *a, double *ev, elpa_request_t *request, int *error)
+	{
+	elpa_eigenvalues_async_a_h_a_dc(handle, a, ev, request, error);
+	}
+inline void elpa_eigenvalues_async(elpa_t handle, std::complex<float>  *a, float  *ev, elpa_request_t *request, int *error)
+	{
+	elpa_eigenvalues_async_a_h_a_fc(handle, a, ev, request, error);
+	}
+#else
+#define elpa_eigenvalues_async(handle, a, ev, request, error) _Generic((a), \
+                double*: \
+                  elpa_eigenvalues_async_a_h_a_d, \
+                \
+                float*: \
+                  elpa_eigenvalues_async_a_h_a_f, \
+                \
+                double complex*: \
+                  elpa_eigenvalues_async_a_h_a_dc, \
+                \
+                float complex*: \
+                  elpa_eigenvalues_async_a_h_a_fc \
+        )(handle, a, ev, request, error)
+#endif
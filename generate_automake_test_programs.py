@@ -629,6 +629,122 @@ for lang, g, gid, deviceptr, p, d, api_name in product(sorted(language_flag.keys
     print("endif\n" * endifs)
     print("endif")
     
+# invert_triangular with the divide-and-conquer algorithm (CPU only)
+for p, d in product(sorted(prec_flag.keys()), sorted(domain_flag.keys())):
+    endifs = 0
+    name = "validate_{d}_{p}_invert_triangular_recursive".format(d=d, p=p)
+
+    print("if BUILD_CPU_TESTS")
+    print("if ENABLE_FORTRAN_TESTS")
+    endifs += 1
+    if (p == "single"):
+        if (d == "real"):
+            print("if WANT_SINGLE_PRECISION_REAL")
+        elif (d == "complex"):
+            print("if WANT_SINGLE_PRECISION_COMPLEX")
+        else:
+            raise Exception("Oh no!")
+        endifs += 1
+
+    print("check_SCRIPTS += " + name + "_default.sh")
+    print("noinst_PROGRAMS += " + name)
+    print(name + "_SOURCES = test/Fortran/test_invert_triangular.F90")
+    print(name + "_LDADD = $(test_program_ldadd)")
+    print(name + "_FCFLAGS = $(test_program_fcflags) \\")
+    print("  " + " \\\n  ".join([
+        domain_flag[d],
+        prec_flag[p],
+        gpu_flag["GPU_OFF"],
+        gpu_id_flag[0],
+        device_pointer_flag[0],
+        "-DTEST_OPTION=\\\"invert_trm_recursive\\\" -DTEST_OPTION_VALUE=1"]))
+    print("endif\n" * endifs)
+    print("endif")
+
+# back_transform with the Householder vectors kept by the ELPA 1stage solver (CPU only)
+for p, d in product(sorted(prec_flag.keys()), sorted(domain_flag.keys())):
+    endifs = 0
+    name = "validate_{d}_{p}_back_transform".format(d=d, p=p)
+
+    print("if BUILD_CPU_TESTS")
+    if (p == "single"):
+        if (d == "real"):
+            print("if WANT_SINGLE_PRECISION_REAL")
+        elif (d == "complex"):
+            print("if WANT_SINGLE_PRECISION_COMPLEX")
+        else:
+            raise Exception("Oh no!")
+        endifs += 1
+
+    print("check_SCRIPTS += " + name + "_default.sh")
+    print("noinst_PROGRAMS += " + name)
+    print(name + "_SOURCES = test/Fortran/test_back_transform.F90")
+    print(name + "_LDADD = $(test_program_ldadd)")
+    print(name + "_FCFLAGS = $(test_program_fcflags) \\")
+    print("  " + " \\\n  ".join([
+        domain_flag[d],
+        prec_flag[p]]))
+    print("endif\n" * endifs)
+    print("endif")
+
+# test.F90 with additional flags, the name of the variant ends with suffix (CPU only)
+def print_variant_test(d, p, t, s, m, suffix, extra_flags, conditionals=[]):
+    name = "validate_{d}_{p}_{t}_{s}_{m}_{suffix}".format(d=d, p=p, t=t, s=s, m=m, suffix=suffix)
+    if s == "2stage":
+        extra_flags = extra_flags + ["-DTEST_KERNEL=ELPA_2STAGE_{0}_DEFAULT".format(d.upper())]
+
+    print("if BUILD_CPU_TESTS")
+    print("if ENABLE_FORTRAN_TESTS")
+    for c in conditionals:
+        print("if " + c)
+    print("check_SCRIPTS += " + name + "_default.sh")
+    print("noinst_PROGRAMS += " + name)
+    print(name + "_SOURCES = test/Fortran/test.F90")
+    print(name + "_LDADD = $(test_program_ldadd)")
+    print(name + "_FCFLAGS = $(test_program_fcflags) \\")
+    print("  -DTEST_CASE=\\\"{0}\\\" \\".format(name))
+    print("  " + " \\\n  ".join([
+        domain_flag[d],
+        prec_flag[p],
+        test_type_flag[t],
+        solver_flag[s],
+        gpu_flag["GPU_OFF"],
+        gpu_id_flag[0],
+        device_pointer_flag[0],
+        qr_flag[0],
+        matrix_flag[m]] + extra_flags))
+    print("endif\n" * (len(conditionals) + 1))
+    print("endif")
+
+# test.F90 with one option set to a non-default value (CPU only)
+def print_option_test(d, p, t, s, m, option, value, conditionals=[], extra_flags=[]):
+    print_variant_test(d, p, t, s, m, option,
+                       ["-DTEST_OPTION=\\\"{0}\\\" -DTEST_OPTION_VALUE={1}".format(option, value)] + extra_flags,
+                       conditionals=conditionals)
+
+print_option_test("real", "double", "generalized", "1stage", "random", "generalized_fused", 1)
+print_option_test("complex", "double", "generalized", "2stage", "random", "generalized_fused", 1)
+# the ring exchange of merge_systems needs more than one process column
+print_option_test("real", "double", "eigenvectors", "2stage", "random", "merge_systems_overlap", 1,
+                  conditionals=["WITH_MPI"], extra_flags=["-DTEST_ONE_PROCESS_ROW"])
+# the leaves of divide and conquer are solved as OpenMP tasks with one process row
+print_option_test("real", "double", "solve_tridiagonal", "1stage", "toeplitz", "solve_tridi_leaf_size", 64,
+                  conditionals=["WITH_OPENMP_TRADITIONAL"], extra_flags=["-DTEST_ONE_PROCESS_ROW"])
+# the look-ahead broadcast of the Householder vectors needs more than one process column
+print_option_test("real", "double", "eigenvectors", "1stage", "random", "trans_ev_lookahead", 1,
+                  conditionals=["WITH_MPI"], extra_flags=["-DTEST_ONE_PROCESS_ROW"])
+# the automatic choice of the number of Householder vectors in trans_ev
+print_option_test("real", "double", "eigenvectors", "1stage", "random", "max_stored_rows", 0)
+# the heap peak measured by the timings against estimate_memory
+for s in ["1stage", "2stage"]:
+    print_variant_test("real", "double", "eigenvectors", s, "random", "memory_estimate",
+                       ["-DTEST_MEMORY_ESTIMATE"], conditionals=["HAVE_DETAILED_TIMINGS"])
+print_variant_test("complex", "double", "eigenvectors", "2stage", "random", "memory_estimate",
+                   ["-DTEST_MEMORY_ESTIMATE"], conditionals=["HAVE_DETAILED_TIMINGS"])
+# round trip of the matrix through write_matrix and read_matrix
+print_variant_test("real", "double", "eigenvectors", "1stage", "random", "matrix_io", ["-DTEST_MATRIX_IO"])
+print_variant_test("complex", "single", "eigenvectors", "2stage", "random", "matrix_io", ["-DTEST_MATRIX_IO"])
+
 name = "validate_multiple_objs_real_double"
 print("if ENABLE_AUTOTUNING")
 print("check_SCRIPTS += " + name + "_extended.sh")
@@ -673,6 +789,128 @@ print("endif")
 print("endif\n")
 print("endif")
 
+name = "validate_async_real_double_c_version"
+print("if BUILD_CPU_TESTS")
+print("if ENABLE_C_TESTS")
+print("check_SCRIPTS += " + name + "_default.sh")
+print("noinst_PROGRAMS += " + name)
+print(name + "_SOURCES = test/C/test_async.c")
+print(name + "_LDADD = $(test_program_ldadd) $(FCLIBS)")
+print(name + "_CFLAGS = $(test_program_cflags) \\")
+print("  " + " \\\n  ".join([
+        domain_flag['real'],
+        prec_flag['double']]))
+print("endif")
+print("endif\n")
+
+name = "validate_trace_real_double_c_version"
+print("if BUILD_CPU_TESTS")
+print("if ENABLE_C_TESTS")
+print("if HAVE_DETAILED_TIMINGS")
+print("check_SCRIPTS += " + name + "_default.sh")
+print("noinst_PROGRAMS += " + name)
+print(name + "_SOURCES = test/C/test_trace.c")
+print(name + "_LDADD = $(test_program_ldadd) $(FCLIBS)")
+print(name + "_CFLAGS = $(test_program_cflags) \\")
+print("  " + " \\\n  ".join([
+        domain_flag['real'],
+        prec_flag['double']]))
+print("endif")
+print("endif")
+print("endif\n")
+
+name = "validate_kernel_model_real_double_c_version"
+print("if BUILD_CPU_TESTS")
+print("if ENABLE_C_TESTS")
+print("check_SCRIPTS += " + name + "_default.sh")
+print("noinst_PROGRAMS += " + name)
+print(name + "_SOURCES = test/C/test_kernel_model.c")
+print(name + "_LDADD = $(test_program_ldadd) $(FCLIBS)")
+print(name + "_CFLAGS = $(test_program_cflags) \\")
+print("  " + " \\\n  ".join([
+        domain_flag['real'],
+        prec_flag['double']]))
+print("endif")
+print("endif\n")
+
+# the processes choose different blockings of trans_ev_band_to_full from their local sizes
+name = "validate_kernel_model_one_process_row_real_double_c_version"
+print("if BUILD_CPU_TESTS")
+print("if ENABLE_C_TESTS")
+print("if WITH_MPI")
+print("check_SCRIPTS += " + name + "_default.sh")
+print("noinst_PROGRAMS += " + name)
+print(name + "_SOURCES = test/C/test_kernel_model.c")
+print(name + "_LDADD = $(test_program_ldadd) $(FCLIBS)")
+print(name + "_CFLAGS = $(test_program_cflags) \\")
+print("  " + " \\\n  ".join([
+        domain_flag['real'],
+        prec_flag['double'],
+        "-DTEST_ONE_PROCESS_ROW"]))
+print("endif")
+print("endif")
+print("endif\n")
+
+name = "validate_reproducible_real_double_c_version"
+print("if BUILD_CPU_TESTS")
+print("if ENABLE_C_TESTS")
+print("check_SCRIPTS += " + name + "_default.sh")
+print("noinst_PROGRAMS += " + name)
+print(name + "_SOURCES = test/C/test_reproducible.c")
+print(name + "_LDADD = $(test_program_ldadd) $(FCLIBS)")
+print(name + "_CFLAGS = $(test_program_cflags) \\")
+print("  " + " \\\n  ".join([
+        domain_flag['real'],
+        prec_flag['double']]))
+print("endif")
+print("endif\n")
+
+name = "validate_dc_fmm_real_double_c_version"
+print("if BUILD_CPU_TESTS")
+print("if ENABLE_C_TESTS")
+print("check_SCRIPTS += " + name + "_default.sh")
+print("noinst_PROGRAMS += " + name)
+print(name + "_SOURCES = test/C/test_dc_fmm.c")
+print(name + "_LDADD = $(test_program_ldadd) $(FCLIBS)")
+print(name + "_CFLAGS = $(test_program_cflags) \\")
+print("  " + " \\\n  ".join([
+        domain_flag['real'],
+        prec_flag['double']]))
+print("endif")
+print("endif\n")
+
+# the ring exchange of merge_systems with dc_fmm needs more than one process column
+name = "validate_dc_fmm_one_process_row_real_double_c_version"
+print("if BUILD_CPU_TESTS")
+print("if ENABLE_C_TESTS")
+print("if WITH_MPI")
+print("check_SCRIPTS += " + name + "_default.sh")
+print("noinst_PROGRAMS += " + name)
+print(name + "_SOURCES = test/C/test_dc_fmm.c")
+print(name + "_LDADD = $(test_program_ldadd) $(FCLIBS)")
+print(name + "_CFLAGS = $(test_program_cflags) \\")
+print("  " + " \\\n  ".join([
+        domain_flag['real'],
+        prec_flag['double'],
+        "-DTEST_ONE_PROCESS_ROW"]))
+print("endif")
+print("endif")
+print("endif\n")
+
+name = "validate_cxx_interface_real_double_cpp_version"
+print("if BUILD_CPU_TESTS")
+print("if ENABLE_CPP_TESTS")
+print("check_SCRIPTS += " + name + "_default.sh")
+print("noinst_PROGRAMS += " + name)
+print(name + "_SOURCES = test/C++/test_cxx_interface.cpp")
+print(name + "_LDADD = $(test_program_ldadd) $(FCLIBS)")
+print(name + "_CXXFLAGS = $(test_program_cxxflags) \\")
+print("  " + " \\\n  ".join([
+        domain_flag['real'],
+        prec_flag['double']]))
+print("endif")
+print("endif\n")
+
 for g, gid, deviceptr in product(sorted(gpu_flag.keys()),
                                  sorted(gpu_id_flag.keys()),
                                  sorted(device_pointer_flag.keys())):
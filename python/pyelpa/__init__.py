@@ -72,8 +72,29 @@ Examples:
 ... # which is stored in a block-cyclic distributed layout
 ... 
 ... # now eigenvalues contains all computed eigenvalues on all cores
+
+
+3. Distribute a global matrix from rank 0 and solve a generalized problem:
+
+>>> import numpy as np
+... from pyelpa import DistributedMatrix
+... from mpi4py import MPI
+... 
+... na = 1000
+... a = DistributedMatrix.from_comm_world(na, na, 16)
+... b = DistributedMatrix.like(a)
+... if MPI.COMM_WORLD.Get_rank() == 0:
+...     a.scatter_from_root(np.diagflat(np.arange(na)**2))
+...     b.scatter_from_root(2.0*np.eye(na))
+... else:
+...     a.scatter_from_root(None)
+...     b.scatter_from_root(None)
+... 
+... data = a.compute_generalized_eigenvectors(b)
+... # collect the eigenvectors on rank 0 (None on the other ranks)
+... eigenvectors = data['eigenvectors'].gather_to_root()
 """
-from .wrapper import Elpa
+from .wrapper import Elpa, ElpaError
 from .distributedmatrix import ProcessorLayout, DistributedMatrix
 
-__all__ = ['ProcessorLayout', 'DistributedMatrix', 'Elpa']
+__all__ = ['ProcessorLayout', 'DistributedMatrix', 'Elpa', 'ElpaError']
@@ -61,6 +61,9 @@ class DistributedMatrix:
         # create array
         self.data = np.empty((self.na_rows, self.na_cols),
                              dtype=dtype, order='F')
+        # global indices of the local rows and columns
+        self.global_rows, self.global_cols = self.get_process_indices(
+            processor_layout.my_prow, processor_layout.my_pcol)
 
         self.elpa = None
 
@@ -125,6 +128,20 @@ class DistributedMatrix:
                                   self.processor_layout.np_cols)
         return global_row, global_col
 
+    def get_process_indices(self, prow, pcol):
+        """global row and column indices of the local matrix of a process
+
+        Returns a tuple of arrays with the global indices of all rows and
+        columns stored on the process with grid coordinates (prow, pcol)
+        """
+        layout = self.processor_layout
+        na_rows = self.numroc(self.na, self.nblk, prow, 0, layout.np_rows)
+        na_cols = self.numroc(self.na, self.nblk, pcol, 0, layout.np_cols)
+        return (self.indxl2g(np.arange(na_rows), self.nblk, prow, 0,
+                             layout.np_rows),
+                self.indxl2g(np.arange(na_cols), self.nblk, pcol, 0,
+                             layout.np_cols))
+
     def is_local_index(self, global_row, global_col):
         """check if global index is stored on current processor"""
         return self.is_local_row(global_row) and self.is_local_col(global_col)
@@ -202,10 +219,10 @@ class DistributedMatrix:
     def _initialized_elpa(function):
         # wrapper to ensure one-time initialization of Elpa object
         @wraps(function)
-        def wrapped_function(self):
+        def wrapped_function(self, *args, **kwargs):
             if self.elpa is None:
                 self.elpa = Elpa.from_distributed_matrix(self)
-            return function(self)
+            return function(self, *args, **kwargs)
         return wrapped_function
 
     @_initialized_elpa
@@ -220,7 +237,7 @@ class DistributedMatrix:
         lost.
         """
         eigenvectors = DistributedMatrix.like(self)
-        eigenvalues = np.zeros(self.na, dtype=np.float64)
+        eigenvalues = np.zeros(self.na, dtype=self.real_dtype)
         # call ELPA
         self.elpa.eigenvectors(self.data, eigenvalues, eigenvectors.data)
         return {'eigenvalues': eigenvalues, 'eigenvectors': eigenvectors}
@@ -234,47 +251,114 @@ class DistributedMatrix:
         After computing the eigenvalues, the original content of the matrix is
         lost.
         """
-        eigenvalues = np.zeros(self.na, dtype=np.float64)
+        eigenvalues = np.zeros(self.na, dtype=self.real_dtype)
         # call ELPA
         self.elpa.eigenvalues(self.data, eigenvalues)
         return eigenvalues
 
+    @_initialized_elpa
+    def compute_generalized_eigenvectors(self, b, is_already_decomposed=False):
+        """Compute eigenvalues and eigenvectors of A x = lambda B x
+
+        A is this matrix, B (DistributedMatrix) has to be positive definite
+        and is overwritten by its Cholesky factor, which is reused in
+        subsequent calls with is_already_decomposed=True.
+        This function returns a dictionary with entries 'eigenvalues' and
+        'eigenvectors'.
+        """
+        eigenvectors = DistributedMatrix.like(self)
+        eigenvalues = np.zeros(self.na, dtype=self.real_dtype)
+        self.elpa.generalized_eigenvectors(self.data, b.data, eigenvalues,
+                                           eigenvectors.data,
+                                           is_already_decomposed)
+        return {'eigenvalues': eigenvalues, 'eigenvectors': eigenvectors}
+
+    @_initialized_elpa
+    def cholesky(self):
+        """Cholesky decomposition A = U^H U in place, U is upper triangular"""
+        self.elpa.cholesky(self.data)
+
+    @_initialized_elpa
+    def invert_triangular(self):
+        """Invert the upper triangular matrix in place"""
+        self.elpa.invert_triangular(self.data)
+
+    @_initialized_elpa
+    def hermitian_multiply(self, b, uplo_a='F', uplo_c='F'):
+        """Return the DistributedMatrix C = A^H B, A is this matrix
+
+        uplo_a and uplo_c ('U', 'L' or 'F') select the parts of A, which are
+        used, and of C, which are computed.
+        """
+        c = DistributedMatrix.like(self)
+        self.elpa.hermitian_multiply(uplo_a, uplo_c, self.na, self.data,
+                                     b.data, c.data)
+        return c
+
+    @property
+    def real_dtype(self):
+        """data type of the eigenvalues"""
+        return np.finfo(self.data.dtype).dtype
+
     def set_data_from_global_matrix(self, matrix):
         """Set local part of the global matrix"""
-        for local_row in range(self.na_rows):
-            for local_col in range(self.na_cols):
-                global_row, global_col = self.get_global_index(local_row,
-                                                               local_col)
-                self.data[local_row, local_col] = matrix[global_row,
-                                                         global_col]
+        self.data[:, :] = matrix[np.ix_(self.global_rows, self.global_cols)]
 
-    def dot(self, vector):
-        """Compute dot product of matrix with vector.
+    def scatter_from_root(self, matrix, root=0):
+        """Distribute the global matrix, which is only needed on rank root
 
-        This blocked implementation is much faster than the naive
-        implementation.
+        Every process receives its local part directly into the data array.
+        """
+        layout = self.processor_layout
+        comm = layout.comm
+        if comm.Get_rank() == root:
+            for rank in range(comm.Get_size()):
+                rows, cols = self.get_process_indices(rank % layout.np_rows,
+                                                      rank // layout.np_rows)
+                block = np.asfortranarray(matrix[np.ix_(rows, cols)],
+                                          dtype=self.data.dtype)
+                if rank == root:
+                    self.data[:, :] = block
+                elif block.size > 0:
+                    comm.Send(block, dest=rank, tag=root)
+        elif self.data.size > 0:
+            comm.Recv(self.data, source=root, tag=root)
+
+    def gather_to_root(self, root=0):
+        """Collect the global matrix on rank root
+
+        Returns the global matrix on rank root and None on all other ranks.
         """
+        layout = self.processor_layout
+        comm = layout.comm
+        if comm.Get_rank() != root:
+            if self.data.size > 0:
+                comm.Send(self.data, dest=root, tag=root)
+            return None
+        matrix = np.empty((self.na, self.na), dtype=self.data.dtype)
+        for rank in range(comm.Get_size()):
+            rows, cols = self.get_process_indices(rank % layout.np_rows,
+                                                  rank // layout.np_rows)
+            if rank == root:
+                block = self.data
+            else:
+                block = np.empty((len(rows), len(cols)),
+                                 dtype=self.data.dtype, order='F')
+                if block.size > 0:
+                    comm.Recv(block, source=rank, tag=root)
+            matrix[np.ix_(rows, cols)] = block
+        return matrix
+
+    def dot(self, vector):
+        """Compute dot product of matrix with vector."""
         if len(vector.shape) > 1 or vector.shape[0] != self.na:
             raise ValueError("Error: shape of vector {} incompatible to "
                              "matrix of size {:d}x{:d}.".format(
                                  vector.shape, self.na, self.na))
         from mpi4py import MPI
         summation = np.zeros_like(vector)
-        # loop only over blocks here
-        for local_row in range(0, self.na_rows, self.nblk):
-            for local_col in range(0, self.na_cols, self.nblk):
-                # do not go beyond the end of the matrix
-                row_block_size = min(local_row + self.nblk,
-                                     self.na_rows) - local_row
-                col_block_size = min(local_col + self.nblk,
-                                     self.na_cols) - local_col
-                global_row, global_col = self.get_global_index(local_row,
-                                                               local_col)
-                # use numpy for faster dot product of local block
-                summation[global_row:global_row+row_block_size] += \
-                    np.dot(self.data[local_row:local_row + row_block_size,
-                                     local_col:local_col + col_block_size],
-                           vector[global_col:global_col+col_block_size])
+        summation[self.global_rows] = np.dot(self.data,
+                                             vector[self.global_cols])
         result = np.zeros_like(vector)
         self.processor_layout.comm.Allreduce(summation, result, op=MPI.SUM)
         return result
@@ -302,12 +386,8 @@ class DistributedMatrix:
         column = np.zeros(self.na, dtype=self.data.dtype)
         temporary = np.zeros_like(column)
         if self.is_local_col(global_col):
-            for global_row in range(self.na):
-                if not self.is_local_row(global_row):
-                    continue
-                local_row, local_col = self.get_local_index(global_row,
-                                                            global_col)
-                temporary[global_row] = self.data[local_row, local_col]
+            _, local_col = self.get_local_index(0, global_col)
+            temporary[self.global_rows] = self.data[:, local_col]
         # this could be done more efficiently with a gather
         self.processor_layout.comm.Allreduce(temporary, column, op=MPI.SUM)
         return column
@@ -318,12 +398,8 @@ class DistributedMatrix:
         row = np.zeros(self.na, dtype=self.data.dtype)
         temporary = np.zeros_like(row)
         if self.is_local_row(global_row):
-            for global_col in range(self.na):
-                if not self.is_local_col(global_col):
-                    continue
-                local_row, local_col = self.get_local_index(global_row,
-                                                            global_col)
-                temporary[global_col] = self.data[local_row, local_col]
+            local_row, _ = self.get_local_index(global_row, 0)
+            temporary[self.global_cols] = self.data[local_row, :]
         # this could be done more efficiently with a gather
         self.processor_layout.comm.Allreduce(temporary, row, op=MPI.SUM)
         return row
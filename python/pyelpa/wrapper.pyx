@@ -1,7 +1,13 @@
+# cython: language_level=3, boundscheck=False, wraparound=False
 """wrapper.pyx -- python wrapper for ELPA
 
 This file contains the cython part of the wrapper.
+
+The matrices are passed as typed memoryviews of Fortran-ordered arrays
+(buffer protocol), so the local blocks of numpy arrays are handed to ELPA
+without copies. The GIL is released while ELPA computes.
 """
+cimport cython
 cimport numpy as np
 import numpy as np
 import sys
@@ -11,15 +17,19 @@ if 'mpi4py.MPI' in sys.modules.keys():
                               'otherwise there will be MPI problems.')
 
 # import the function definitions from the ELPA header
-cdef import from "<elpa/elpa.h>":
+cdef extern from "<elpa/elpa.h>" nogil:
     cdef struct elpa_struct:
         pass
     ctypedef elpa_struct *elpa_t
+    cdef struct elpa_autotune_struct:
+        pass
+    ctypedef elpa_autotune_struct *elpa_autotune_t
     int elpa_init(int api_version)
     void elpa_uninit(int *error)
     elpa_t elpa_allocate(int *error)
     void elpa_deallocate(elpa_t handle, int *error)
     int elpa_setup(elpa_t handle)
+    const char *elpa_strerr(int elpa_error)
     void elpa_set_integer(elpa_t handle, const char *name, int value, int *error)
     void elpa_get_integer(elpa_t handle, const char *name, int *value, int *error)
     void elpa_set_double(elpa_t handle, const char *name, double value, int *error)
@@ -32,198 +42,411 @@ cdef import from "<elpa/elpa.h>":
     void elpa_eigenvalues_a_h_a_f(elpa_t handle, float *a, float *ev, int *error)
     void elpa_eigenvalues_a_h_a_dc(elpa_t handle, double complex *a, double *ev, int *error)
     void elpa_eigenvalues_a_h_a_fc(elpa_t handle, float complex *a, float *ev, int *error)
+    void elpa_generalized_eigenvectors_d(elpa_t handle, double *a, double *b, double *ev, double *q, int is_already_decomposed, int *error)
+    void elpa_generalized_eigenvectors_f(elpa_t handle, float *a, float *b, float *ev, float *q, int is_already_decomposed, int *error)
+    void elpa_generalized_eigenvectors_dc(elpa_t handle, double complex *a, double complex *b, double *ev, double complex *q, int is_already_decomposed, int *error)
+    void elpa_generalized_eigenvectors_fc(elpa_t handle, float complex *a, float complex *b, float *ev, float complex *q, int is_already_decomposed, int *error)
+    void elpa_generalized_eigenvalues_d(elpa_t handle, double *a, double *b, double *ev, int is_already_decomposed, int *error)
+    void elpa_generalized_eigenvalues_f(elpa_t handle, float *a, float *b, float *ev, int is_already_decomposed, int *error)
+    void elpa_generalized_eigenvalues_dc(elpa_t handle, double complex *a, double complex *b, double *ev, int is_already_decomposed, int *error)
+    void elpa_generalized_eigenvalues_fc(elpa_t handle, float complex *a, float complex *b, float *ev, int is_already_decomposed, int *error)
+    void elpa_cholesky_a_h_a_d(elpa_t handle, double *a, int *error)
+    void elpa_cholesky_a_h_a_f(elpa_t handle, float *a, int *error)
+    void elpa_cholesky_a_h_a_dc(elpa_t handle, double complex *a, int *error)
+    void elpa_cholesky_a_h_a_fc(elpa_t handle, float complex *a, int *error)
+    void elpa_invert_trm_a_h_a_d(elpa_t handle, double *a, int *error)
+    void elpa_invert_trm_a_h_a_f(elpa_t handle, float *a, int *error)
+    void elpa_invert_trm_a_h_a_dc(elpa_t handle, double complex *a, int *error)
+    void elpa_invert_trm_a_h_a_fc(elpa_t handle, float complex *a, int *error)
+    void elpa_hermitian_multiply_a_h_a_d(elpa_t handle, char uplo_a, char uplo_c, int ncb, double *a, double *b, int nrows_b, int ncols_b, double *c, int nrows_c, int ncols_c, int *error)
+    void elpa_hermitian_multiply_a_h_a_f(elpa_t handle, char uplo_a, char uplo_c, int ncb, float *a, float *b, int nrows_b, int ncols_b, float *c, int nrows_c, int ncols_c, int *error)
+    void elpa_hermitian_multiply_a_h_a_dc(elpa_t handle, char uplo_a, char uplo_c, int ncb, double complex *a, double complex *b, int nrows_b, int ncols_b, double complex *c, int nrows_c, int ncols_c, int *error)
+    void elpa_hermitian_multiply_a_h_a_fc(elpa_t handle, char uplo_a, char uplo_c, int ncb, float complex *a, float complex *b, int nrows_b, int ncols_b, float complex *c, int nrows_c, int ncols_c, int *error)
+    void elpa_solve_tridiagonal_d(elpa_t handle, double *d, double *e, double *q, int *error)
+    void elpa_solve_tridiagonal_f(elpa_t handle, float *d, float *e, float *q, int *error)
     int ELPA_OK
+    int ELPA_ERROR
     int ELPA_SOLVER_2STAGE
+    int ELPA_AUTOTUNE_FAST
+    int ELPA_AUTOTUNE_DOMAIN_REAL
+    int ELPA_AUTOTUNE_DOMAIN_COMPLEX
+
+# the skew-symmetric solver and autotuning are optional features of ELPA
+cdef extern from *:
+    """
+    #include "config.h"
+    #ifdef HAVE_SKEWSYMMETRIC
+    #define PYELPA_HAVE_SKEWSYMMETRIC 1
+    /* elpa.h has been included before config.h */
+    void elpa_skew_eigenvectors_a_h_a_d(elpa_t handle, double *a, double *ev, double *q, int *error);
+    void elpa_skew_eigenvectors_a_h_a_f(elpa_t handle, float *a, float *ev, float *q, int *error);
+    void elpa_skew_eigenvalues_a_h_a_d(elpa_t handle, double *a, double *ev, int *error);
+    void elpa_skew_eigenvalues_a_h_a_f(elpa_t handle, float *a, float *ev, int *error);
+    #else
+    #define PYELPA_HAVE_SKEWSYMMETRIC 0
+    static void elpa_skew_eigenvectors_a_h_a_d(elpa_t h, double *a, double *ev, double *q, int *error) { *error = ELPA_ERROR; }
+    static void elpa_skew_eigenvectors_a_h_a_f(elpa_t h, float *a, float *ev, float *q, int *error) { *error = ELPA_ERROR; }
+    static void elpa_skew_eigenvalues_a_h_a_d(elpa_t h, double *a, double *ev, int *error) { *error = ELPA_ERROR; }
+    static void elpa_skew_eigenvalues_a_h_a_f(elpa_t h, float *a, float *ev, int *error) { *error = ELPA_ERROR; }
+    #endif
+    #ifdef ENABLE_AUTOTUNING
+    #define PYELPA_HAVE_AUTOTUNING 1
+    #else
+    #define PYELPA_HAVE_AUTOTUNING 0
+    static elpa_autotune_t elpa_autotune_setup(elpa_t h, int level, int domain, int *error) { *error = ELPA_ERROR; return NULL; }
+    static int elpa_autotune_step(elpa_t h, elpa_autotune_t t, int *error) { *error = ELPA_ERROR; return 0; }
+    static void elpa_autotune_set_best(elpa_t h, elpa_autotune_t t, int *error) { *error = ELPA_ERROR; }
+    static void elpa_autotune_print_state(elpa_t h, elpa_autotune_t t, int *error) { *error = ELPA_ERROR; }
+    static void elpa_autotune_deallocate(elpa_autotune_t t, int *error) { *error = ELPA_ERROR; }
+    #endif
+    """
+    int PYELPA_HAVE_SKEWSYMMETRIC
+    int PYELPA_HAVE_AUTOTUNING
+    void elpa_skew_eigenvectors_a_h_a_d(elpa_t handle, double *a, double *ev, double *q, int *error) nogil
+    void elpa_skew_eigenvectors_a_h_a_f(elpa_t handle, float *a, float *ev, float *q, int *error) nogil
+    void elpa_skew_eigenvalues_a_h_a_d(elpa_t handle, double *a, double *ev, int *error) nogil
+    void elpa_skew_eigenvalues_a_h_a_f(elpa_t handle, float *a, float *ev, int *error) nogil
+    elpa_autotune_t elpa_autotune_setup(elpa_t handle, int level, int domain, int *error)
+    int elpa_autotune_step(elpa_t handle, elpa_autotune_t autotune_handle, int *error) nogil
+    void elpa_autotune_set_best(elpa_t handle, elpa_autotune_t autotune_handle, int *error)
+    void elpa_autotune_print_state(elpa_t handle, elpa_autotune_t autotune_handle, int *error)
+    void elpa_autotune_deallocate(elpa_autotune_t autotune_handle, int *error)
+
+
+# matrix elements and the corresponding eigenvalues
+ctypedef fused scalar_t:
+    double
+    float
+    double complex
+    float complex
+
+ctypedef fused real_t:
+    double
+    float
+
+HAVE_SKEWSYMMETRIC = bool(PYELPA_HAVE_SKEWSYMMETRIC)
+HAVE_AUTOTUNING = bool(PYELPA_HAVE_AUTOTUNING)
+
+
+class ElpaError(RuntimeError):
+    """Error reported by ELPA; the ELPA error code is in the attribute code"""
+    def __init__(self, int code, what):
+        self.code = code
+        super().__init__("ELPA: {:s} returned error {:d}: {:s}".format(
+            what, code, elpa_strerr(code).decode('ascii')))
+
+
+cdef inline void check_error(int error, what) except *:
+    if error != ELPA_OK:
+        raise ElpaError(error, what)
+
+
+cdef inline check_precision(scalar_t *a, real_t *ev):
+    """the eigenvalues must have the precision of the matrix"""
+    if scalar_t is double or scalar_t is cython.doublecomplex:
+        if real_t is float:
+            raise TypeError("The eigenvalues must be of type float64.")
+    elif real_t is double:
+        raise TypeError("The eigenvalues must be of type float32.")
+
+
+cdef bytes to_bytes(description):
+    if isinstance(description, unicode):
+        # encode to ascii for passing to C
+        return (<unicode>description).encode('ascii')
+    return description
+
+
+cdef class AutotuneState:
+    """State of an autotuning run, see Elpa.autotune_setup"""
+    cdef elpa_autotune_t handle
+
+    def __dealloc__(self):
+        cdef int error
+        if self.handle != NULL:
+            elpa_autotune_deallocate(self.handle, &error)
 
 
 cdef class Elpa:
     """Wrapper for ELPA C interface.
 
     Provides routines for initialization, deinitialization, setting and getting
-    properties and for calling the eigenvectors and eigenvalues routines.
-    The routines eigenvectors and eigenvalues select the right ELPA routine to
-    call depending on the argument type.
+    properties and for calling the solvers, the Cholesky decomposition, the
+    inversion of triangular matrices, the multiplication of hermitian matrices
+    and the autotuning.
+    The routines select the right ELPA routine depending on the argument type.
+    All matrices are the local parts of block-cyclic distributed matrices, as
+    Fortran-ordered arrays (order='F') of shape (local_nrows, local_ncols);
+    they are passed to ELPA without copies.
     """
     cdef elpa_t handle
 
-    def __init__(self):
+    def __cinit__(self):
         """Run initialization and allocation of handle"""
+        cdef int error
+        self.handle = NULL
         if elpa_init(20171201) != ELPA_OK:
             raise RuntimeError("ELPA API version not supported")
+        self.handle = elpa_allocate(&error)
+        check_error(error, "elpa_allocate")
+
+    def __dealloc__(self):
+        """Deallocation of handle and deinitialization"""
         cdef int error
-        handle = elpa_allocate(&error)
-        self.handle = handle
+        if self.handle != NULL:
+            elpa_deallocate(self.handle, &error)
+            elpa_uninit(&error)
 
     def set_integer(self, description, int value):
         """Wraps elpa_set_integer"""
         cdef int error
-        if isinstance(description, unicode):
-            # encode to ascii for passing to C
-            description = (<unicode>description).encode('ascii')
-        cdef const char* c_string = description
-        elpa_set_integer(<elpa_t>self.handle, description, value, &error)
+        cdef bytes name = to_bytes(description)
+        elpa_set_integer(self.handle, name, value, &error)
+        check_error(error, "setting " + name.decode('ascii'))
 
     def get_integer(self, description):
         """Wraps elpa_get_integer"""
         cdef int error
-        if isinstance(description, unicode):
-            # encode to ascii for passing to C
-            description = (<unicode>description).encode('ascii')
-        cdef const char* c_string = description
         cdef int tmp
-        elpa_get_integer(<elpa_t>self.handle, c_string, &tmp, &error)
+        cdef bytes name = to_bytes(description)
+        elpa_get_integer(self.handle, name, &tmp, &error)
+        check_error(error, "getting " + name.decode('ascii'))
         return tmp
 
     def set_double(self, description, double value):
         """Wraps elpa_set_double"""
         cdef int error
-        if isinstance(description, unicode):
-            # encode to ascii for passing to C
-            description = (<unicode>description).encode('ascii')
-        cdef const char* c_string = description
-        elpa_set_double(<elpa_t>self.handle, description, value, &error)
+        cdef bytes name = to_bytes(description)
+        elpa_set_double(self.handle, name, value, &error)
+        check_error(error, "setting " + name.decode('ascii'))
 
     def get_double(self, description):
         """Wraps elpa_get_double"""
         cdef int error
-        if isinstance(description, unicode):
-            # encode to ascii for passing to C
-            description = (<unicode>description).encode('ascii')
-        cdef const char* c_string = description
         cdef double tmp
-        elpa_get_double(<elpa_t>self.handle, c_string, &tmp, &error)
+        cdef bytes name = to_bytes(description)
+        elpa_get_double(self.handle, name, &tmp, &error)
+        check_error(error, "getting " + name.decode('ascii'))
         return tmp
 
     def setup(self):
         """call setup function"""
-        elpa_setup(<elpa_t>self.handle)
+        check_error(elpa_setup(self.handle), "elpa_setup")
 
-    def __del__(self):
-        """Deallocation of handle and deinitialization"""
-        cdef int error
-        elpa_deallocate(<elpa_t>self.handle, &error)
-        elpa_uninit(&error)
-
-    def eigenvectors_d(self,
-                       np.ndarray[np.float64_t, ndim=2] a,
-                       np.ndarray[np.float64_t, ndim=1] ev,
-                       np.ndarray[np.float64_t, ndim=2] q):
-        cdef int error
-        elpa_eigenvectors_a_h_a_d(<elpa_t>self.handle, <np.float64_t *>a.data,
-                            <np.float64_t *>ev.data, <np.float64_t *>q.data,
-                            <int*>&error)
-        if error != ELPA_OK:
-            raise RuntimeError("ELPA returned error value {:d}.".format(error))
-
-    def eigenvectors_f(self,
-                       np.ndarray[np.float32_t, ndim=2] a,
-                       np.ndarray[np.float32_t, ndim=1] ev,
-                       np.ndarray[np.float32_t, ndim=2] q):
-        cdef int error
-        elpa_eigenvectors_a_h_a_f(<elpa_t>self.handle, <np.float32_t *>a.data,
-                            <np.float32_t *>ev.data, <np.float32_t *>q.data,
-                            <int*>&error)
-        if error != ELPA_OK:
-            raise RuntimeError("ELPA returned error value {:d}.".format(error))
-
-    def eigenvectors_dc(self,
-                        np.ndarray[np.complex128_t, ndim=2] a,
-                        np.ndarray[np.float64_t, ndim=1] ev,
-                        np.ndarray[np.complex128_t, ndim=2] q):
-        cdef int error
-        elpa_eigenvectors_a_h_a_dc(<elpa_t>self.handle, <np.complex128_t *>a.data,
-                             <np.float64_t *>ev.data, <np.complex128_t *>q.data,
-                             <int*>&error)
-        if error != ELPA_OK:
-            raise RuntimeError("ELPA returned error value {:d}.".format(error))
-
-    def eigenvectors_fc(self,
-                        np.ndarray[np.complex64_t, ndim=2] a,
-                        np.ndarray[np.float32_t, ndim=1] ev,
-                        np.ndarray[np.complex64_t, ndim=2] q):
-        cdef int error
-        elpa_eigenvectors_a_h_a_fc(<elpa_t>self.handle, <np.complex64_t *>a.data,
-                             <np.float32_t *>ev.data, <np.complex64_t *>q.data,
-                             <int*>&error)
-        if error != ELPA_OK:
-            raise RuntimeError("ELPA returned error value {:d}.".format(error))
-
-    def eigenvectors(self, a, ev, q):
+    def eigenvectors(self, scalar_t[::1, :] a, real_t[::1] ev, scalar_t[::1, :] q):
         """Compute eigenvalues and eigenvectors.
 
-        The data type of a is tested and the corresponding ELPA routine called
-
         Args:
-            a (DistributedMatrix): problem matrix
-            ev (numpy.ndarray): array of size a.na to store eigenvalues
-            q (DistributedMatrix): store eigenvectors
+            a: local part of the problem matrix, overwritten
+            ev (numpy.ndarray): array of size na to store eigenvalues
+            q: local part of the matrix to store the eigenvectors
         """
-        if a.dtype == np.float64:
-            self.eigenvectors_d(a, ev, q)
-        elif a.dtype == np.float32:
-            self.eigenvectors_f(a, ev, q)
-        elif a.dtype == np.complex128:
-            self.eigenvectors_dc(a, ev, q)
-        elif a.dtype == np.complex64:
-            self.eigenvectors_fc(a, ev, q)
-        else:
-            raise TypeError("Type not known.")
-
-    def eigenvalues_d(self,
-                       np.ndarray[np.float64_t, ndim=2] a,
-                       np.ndarray[np.float64_t, ndim=1] ev):
-        cdef int error
-        elpa_eigenvalues_a_h_a_d(<elpa_t>self.handle, <np.float64_t *>a.data,
-                           <np.float64_t *>ev.data, <int*>&error)
-        if error != ELPA_OK:
-            raise RuntimeError("ELPA returned error value {:d}.".format(error))
-
-    def eigenvalues_f(self,
-                       np.ndarray[np.float32_t, ndim=2] a,
-                       np.ndarray[np.float32_t, ndim=1] ev):
-        cdef int error
-        elpa_eigenvalues_a_h_a_f(<elpa_t>self.handle, <np.float32_t *>a.data,
-                           <np.float32_t *>ev.data, <int*>&error)
-        if error != ELPA_OK:
-            raise RuntimeError("ELPA returned error value {:d}.".format(error))
-
-    def eigenvalues_dc(self,
-                        np.ndarray[np.complex128_t, ndim=2] a,
-                        np.ndarray[np.float64_t, ndim=1] ev):
-        cdef int error
-        elpa_eigenvalues_a_h_a_dc(<elpa_t>self.handle, <np.complex128_t *>a.data,
-                            <np.float64_t *>ev.data, <int*>&error)
-        if error != ELPA_OK:
-            raise RuntimeError("ELPA returned error value {:d}.".format(error))
-
-    def eigenvalues_fc(self,
-                        np.ndarray[np.complex64_t, ndim=2] a,
-                        np.ndarray[np.float32_t, ndim=1] ev):
-        cdef int error
-        elpa_eigenvalues_a_h_a_fc(<elpa_t>self.handle, <np.complex64_t *>a.data,
-                            <np.float32_t *>ev.data, <int*>&error)
-        if error != ELPA_OK:
-            raise RuntimeError("ELPA returned error value {:d}.".format(error))
-
-    def eigenvalues(self, a, ev):
+        cdef int error
+        check_precision(&a[0, 0], &ev[0])
+        with nogil:
+            if scalar_t is double:
+                elpa_eigenvectors_a_h_a_d(self.handle, &a[0, 0], <double*>&ev[0], &q[0, 0], &error)
+            elif scalar_t is float:
+                elpa_eigenvectors_a_h_a_f(self.handle, &a[0, 0], <float*>&ev[0], &q[0, 0], &error)
+            elif scalar_t is cython.doublecomplex:
+                elpa_eigenvectors_a_h_a_dc(self.handle, &a[0, 0], <double*>&ev[0], &q[0, 0], &error)
+            else:
+                elpa_eigenvectors_a_h_a_fc(self.handle, &a[0, 0], <float*>&ev[0], &q[0, 0], &error)
+        check_error(error, "eigenvectors")
+
+    def eigenvalues(self, scalar_t[::1, :] a, real_t[::1] ev):
         """Compute eigenvalues.
 
-        The data type of a is tested and the corresponding ELPA routine called
+        Args:
+            a: local part of the problem matrix, overwritten
+            ev (numpy.ndarray): array of size na to store eigenvalues
+        """
+        cdef int error
+        check_precision(&a[0, 0], &ev[0])
+        with nogil:
+            if scalar_t is double:
+                elpa_eigenvalues_a_h_a_d(self.handle, &a[0, 0], <double*>&ev[0], &error)
+            elif scalar_t is float:
+                elpa_eigenvalues_a_h_a_f(self.handle, &a[0, 0], <float*>&ev[0], &error)
+            elif scalar_t is cython.doublecomplex:
+                elpa_eigenvalues_a_h_a_dc(self.handle, &a[0, 0], <double*>&ev[0], &error)
+            else:
+                elpa_eigenvalues_a_h_a_fc(self.handle, &a[0, 0], <float*>&ev[0], &error)
+        check_error(error, "eigenvalues")
+
+    def skew_eigenvectors(self, real_t[::1, :] a, real_t[::1] ev, real_t[::1, :] q):
+        """Compute eigenvalues and eigenvectors of a real skew-symmetric matrix.
+
+        Args:
+            a: local part of the problem matrix, overwritten
+            ev (numpy.ndarray): array of size na to store eigenvalues
+            q: local part of the eigenvectors, shape (local_nrows, 2*local_ncols):
+               real parts followed by imaginary parts
+        """
+        cdef int error
+        if q.shape[1] < 2*a.shape[1]:
+            raise ValueError("q must have twice as many columns as a")
+        with nogil:
+            if real_t is double:
+                elpa_skew_eigenvectors_a_h_a_d(self.handle, &a[0, 0], &ev[0], &q[0, 0], &error)
+            else:
+                elpa_skew_eigenvectors_a_h_a_f(self.handle, &a[0, 0], &ev[0], &q[0, 0], &error)
+        check_error(error, "skew_eigenvectors")
+
+    def skew_eigenvalues(self, real_t[::1, :] a, real_t[::1] ev):
+        """Compute eigenvalues of a real skew-symmetric matrix."""
+        cdef int error
+        with nogil:
+            if real_t is double:
+                elpa_skew_eigenvalues_a_h_a_d(self.handle, &a[0, 0], &ev[0], &error)
+            else:
+                elpa_skew_eigenvalues_a_h_a_f(self.handle, &a[0, 0], &ev[0], &error)
+        check_error(error, "skew_eigenvalues")
+
+    def generalized_eigenvectors(self, scalar_t[::1, :] a, scalar_t[::1, :] b,
+                                 real_t[::1] ev, scalar_t[::1, :] q,
+                                 bint is_already_decomposed=False):
+        """Compute eigenvalues and eigenvectors of the problem A x = lambda B x.
 
         Args:
-            a (DistributedMatrix): problem matrix
-            ev (numpy.ndarray): array of size a.na to store eigenvalues
+            a: local part of the hermitian matrix A, overwritten
+            b: local part of the positive definite matrix B, overwritten by
+               its Cholesky factor; reused if is_already_decomposed
+            ev (numpy.ndarray): array of size na to store eigenvalues
+            q: local part of the matrix to store the eigenvectors
         """
-        if a.dtype == np.float64:
-            self.eigenvalues_d(a, ev)
-        elif a.dtype == np.float32:
-            self.eigenvalues_f(a, ev)
-        elif a.dtype == np.complex128:
-            self.eigenvalues_dc(a, ev)
-        elif a.dtype == np.complex64:
-            self.eigenvalues_fc(a, ev)
-        else:
-            raise TypeError("Type not known.")
+        cdef int error
+        cdef int decomposed = is_already_decomposed
+        check_precision(&a[0, 0], &ev[0])
+        with nogil:
+            if scalar_t is double:
+                elpa_generalized_eigenvectors_d(self.handle, &a[0, 0], &b[0, 0], <double*>&ev[0], &q[0, 0], decomposed, &error)
+            elif scalar_t is float:
+                elpa_generalized_eigenvectors_f(self.handle, &a[0, 0], &b[0, 0], <float*>&ev[0], &q[0, 0], decomposed, &error)
+            elif scalar_t is cython.doublecomplex:
+                elpa_generalized_eigenvectors_dc(self.handle, &a[0, 0], &b[0, 0], <double*>&ev[0], &q[0, 0], decomposed, &error)
+            else:
+                elpa_generalized_eigenvectors_fc(self.handle, &a[0, 0], &b[0, 0], <float*>&ev[0], &q[0, 0], decomposed, &error)
+        check_error(error, "generalized_eigenvectors")
+
+    def generalized_eigenvalues(self, scalar_t[::1, :] a, scalar_t[::1, :] b,
+                                real_t[::1] ev, bint is_already_decomposed=False):
+        """Compute eigenvalues of the problem A x = lambda B x."""
+        cdef int error
+        cdef int decomposed = is_already_decomposed
+        check_precision(&a[0, 0], &ev[0])
+        with nogil:
+            if scalar_t is double:
+                elpa_generalized_eigenvalues_d(self.handle, &a[0, 0], &b[0, 0], <double*>&ev[0], decomposed, &error)
+            elif scalar_t is float:
+                elpa_generalized_eigenvalues_f(self.handle, &a[0, 0], &b[0, 0], <float*>&ev[0], decomposed, &error)
+            elif scalar_t is cython.doublecomplex:
+                elpa_generalized_eigenvalues_dc(self.handle, &a[0, 0], &b[0, 0], <double*>&ev[0], decomposed, &error)
+            else:
+                elpa_generalized_eigenvalues_fc(self.handle, &a[0, 0], &b[0, 0], <float*>&ev[0], decomposed, &error)
+        check_error(error, "generalized_eigenvalues")
+
+    def cholesky(self, scalar_t[::1, :] a):
+        """Cholesky decomposition A = U^H U in place; U is upper triangular"""
+        cdef int error
+        with nogil:
+            if scalar_t is double:
+                elpa_cholesky_a_h_a_d(self.handle, &a[0, 0], &error)
+            elif scalar_t is float:
+                elpa_cholesky_a_h_a_f(self.handle, &a[0, 0], &error)
+            elif scalar_t is cython.doublecomplex:
+                elpa_cholesky_a_h_a_dc(self.handle, &a[0, 0], &error)
+            else:
+                elpa_cholesky_a_h_a_fc(self.handle, &a[0, 0], &error)
+        check_error(error, "cholesky")
+
+    def invert_triangular(self, scalar_t[::1, :] a):
+        """Inversion of an upper triangular matrix in place"""
+        cdef int error
+        with nogil:
+            if scalar_t is double:
+                elpa_invert_trm_a_h_a_d(self.handle, &a[0, 0], &error)
+            elif scalar_t is float:
+                elpa_invert_trm_a_h_a_f(self.handle, &a[0, 0], &error)
+            elif scalar_t is cython.doublecomplex:
+                elpa_invert_trm_a_h_a_dc(self.handle, &a[0, 0], &error)
+            else:
+                elpa_invert_trm_a_h_a_fc(self.handle, &a[0, 0], &error)
+        check_error(error, "invert_triangular")
+
+    def hermitian_multiply(self, uplo_a, uplo_c, int ncb, scalar_t[::1, :] a,
+                           scalar_t[::1, :] b, scalar_t[::1, :] c):
+        """C = A^H B for the first ncb columns of B
+
+        Args:
+            uplo_a ('U', 'L' or 'F'): the part of A, which is used
+            uplo_c ('U', 'L' or 'F'): the part of C, which is computed
+            ncb (int): number of columns of the global matrices B and C
+            a, b, c: local parts of the matrices
+        """
+        cdef int error
+        cdef char ua = ord(uplo_a)
+        cdef char uc = ord(uplo_c)
+        cdef int nrows_b = b.shape[0], ncols_b = b.shape[1]
+        cdef int nrows_c = c.shape[0], ncols_c = c.shape[1]
+        with nogil:
+            if scalar_t is double:
+                elpa_hermitian_multiply_a_h_a_d(self.handle, ua, uc, ncb, &a[0, 0], &b[0, 0], nrows_b, ncols_b,
+                                                &c[0, 0], nrows_c, ncols_c, &error)
+            elif scalar_t is float:
+                elpa_hermitian_multiply_a_h_a_f(self.handle, ua, uc, ncb, &a[0, 0], &b[0, 0], nrows_b, ncols_b,
+                                                &c[0, 0], nrows_c, ncols_c, &error)
+            elif scalar_t is cython.doublecomplex:
+                elpa_hermitian_multiply_a_h_a_dc(self.handle, ua, uc, ncb, &a[0, 0], &b[0, 0], nrows_b, ncols_b,
+                                                 &c[0, 0], nrows_c, ncols_c, &error)
+            else:
+                elpa_hermitian_multiply_a_h_a_fc(self.handle, ua, uc, ncb, &a[0, 0], &b[0, 0], nrows_b, ncols_b,
+                                                 &c[0, 0], nrows_c, ncols_c, &error)
+        check_error(error, "hermitian_multiply")
+
+    def solve_tridiagonal(self, real_t[::1] d, real_t[::1] e, real_t[::1, :] q):
+        """Eigenvalues (in d) and eigenvectors (in q) of a tridiagonal matrix
+        with diagonal d and off-diagonal e"""
+        cdef int error
+        with nogil:
+            if real_t is double:
+                elpa_solve_tridiagonal_d(self.handle, &d[0], &e[0], &q[0, 0], &error)
+            else:
+                elpa_solve_tridiagonal_f(self.handle, &d[0], &e[0], &q[0, 0], &error)
+        check_error(error, "solve_tridiagonal")
+
+    def autotune_setup(self, int level=ELPA_AUTOTUNE_FAST, int domain=ELPA_AUTOTUNE_DOMAIN_REAL):
+        """Start autotuning; returns an AutotuneState for autotune_step"""
+        cdef int error
+        cdef AutotuneState state = AutotuneState()
+        state.handle = elpa_autotune_setup(self.handle, level, domain, &error)
+        check_error(error, "autotune_setup")
+        return state
+
+    def autotune_step(self, AutotuneState state):
+        """Set the next set of parameters; returns False if the tuning is done"""
+        cdef int error
+        cdef int unfinished
+        with nogil:
+            unfinished = elpa_autotune_step(self.handle, state.handle, &error)
+        check_error(error, "autotune_step")
+        return unfinished == 1
+
+    def autotune_set_best(self, AutotuneState state):
+        """Set the best parameters found so far"""
+        cdef int error
+        elpa_autotune_set_best(self.handle, state.handle, &error)
+        check_error(error, "autotune_set_best")
+
+    def autotune_print_state(self, AutotuneState state):
+        """Print the state of the autotuning"""
+        cdef int error
+        elpa_autotune_print_state(self.handle, state.handle, &error)
+        check_error(error, "autotune_print_state")
+
+    # names of the previous, type-specific interface
+    eigenvectors_d = eigenvectors_f = eigenvectors_dc = eigenvectors_fc = eigenvectors
+    eigenvalues_d = eigenvalues_f = eigenvalues_dc = eigenvalues_fc = eigenvalues
 
     @classmethod
     def from_distributed_matrix(cls, a):
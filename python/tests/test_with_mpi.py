@@ -436,3 +436,117 @@ def test_global_block_access(na, nev, nblk):
         for i, j in a.global_indices():
             x = a.get_data_for_global_index(i, j)
             assert(np.isclose(x, i*j))
+
+
+@pytest.mark.parametrize("na,nev,nblk", parameter_list)
+def test_scatter_and_gather(na, nev, nblk):
+    import numpy as np
+    from pyelpa import DistributedMatrix
+
+    for dtype in [np.float64, np.complex128]:
+        a = DistributedMatrix.from_comm_world(na, nev, nblk, dtype=dtype)
+        matrix = get_random_vector(na*na).reshape(na, na).astype(dtype)
+        is_root = a.processor_layout.comm.Get_rank() == 0
+
+        a.scatter_from_root(matrix if is_root else None)
+        for local_row in range(a.na_rows):
+            for local_col in range(a.na_cols):
+                global_row, global_col = a.get_global_index(local_row,
+                                                            local_col)
+                assert(a.data[local_row, local_col] ==
+                       matrix[global_row, global_col])
+
+        gathered = a.gather_to_root()
+        if is_root:
+            assert(np.array_equal(gathered, matrix))
+        else:
+            assert(gathered is None)
+
+
+@pytest.mark.parametrize("na,nev,nblk", parameter_list)
+def test_eigenvalues_single_precision(na, nev, nblk):
+    import numpy as np
+    from pyelpa import DistributedMatrix
+
+    for dtype in [np.float32, np.complex64]:
+        a = DistributedMatrix.from_comm_world(na, nev, nblk, dtype=dtype)
+        matrix = get_random_vector(na*na).reshape(na, na).astype(dtype)
+        matrix = 0.5*(matrix + np.conj(matrix.T))
+        a.set_data_from_global_matrix(matrix)
+
+        eigenvalues = a.compute_eigenvalues()
+        assert(eigenvalues.dtype == np.float32)
+        reference = np.linalg.eigvalsh(matrix.astype(np.complex128))
+        assert(np.allclose(eigenvalues[:nev], reference[:nev], atol=1e-3))
+
+
+def test_wrong_precision_of_eigenvalues():
+    import numpy as np
+    from pyelpa import DistributedMatrix
+
+    a = DistributedMatrix.from_comm_world(50, 20, 16, dtype=np.float64)
+    a.data[:, :] = 0.0
+    eigenvalues = np.zeros(a.na, dtype=np.float32)
+    a.compute_eigenvalues()
+    with pytest.raises(TypeError):
+        a.elpa.eigenvalues(a.data, eigenvalues)
+
+
+def test_elpa_error():
+    from pyelpa import Elpa, ElpaError
+
+    e = Elpa()
+    with pytest.raises(ElpaError) as error:
+        e.set_integer("no_such_option", 1)
+    assert(error.value.code != 0)
+
+
+@pytest.mark.parametrize("na,nev,nblk", parameter_list)
+def test_generalized_eigenvectors(na, nev, nblk):
+    import numpy as np
+    from pyelpa import DistributedMatrix
+
+    for dtype in [np.float64, np.complex128]:
+        a = DistributedMatrix.from_comm_world(na, nev, nblk, dtype=dtype)
+        b = DistributedMatrix.like(a)
+        matrix_a = get_random_vector(na*na).reshape(na, na).astype(dtype)
+        matrix_a = 0.5*(matrix_a + np.conj(matrix_a.T))
+        matrix_b = get_random_vector(na*na).reshape(na, na).astype(dtype)
+        matrix_b = np.dot(np.conj(matrix_b.T), matrix_b) + na*np.eye(na)
+        a.set_data_from_global_matrix(matrix_a)
+        b.set_data_from_global_matrix(matrix_b)
+
+        data = a.compute_generalized_eigenvectors(b)
+        eigenvalues = data['eigenvalues']
+        eigenvectors = data['eigenvectors']
+        for index in range(nev):
+            eigenvector = eigenvectors.get_column(index)
+            assert(np.allclose(np.dot(matrix_a, eigenvector),
+                               eigenvalues[index]*np.dot(matrix_b,
+                                                         eigenvector)))
+
+
+@pytest.mark.parametrize("na,nev,nblk", parameter_list)
+def test_cholesky_and_hermitian_multiply(na, nev, nblk):
+    import numpy as np
+    from pyelpa import DistributedMatrix
+
+    for dtype in [np.float64, np.complex128]:
+        a = DistributedMatrix.from_comm_world(na, nev, nblk, dtype=dtype)
+        matrix = get_random_vector(na*na).reshape(na, na).astype(dtype)
+        matrix = np.dot(np.conj(matrix.T), matrix) + na*np.eye(na)
+        a.set_data_from_global_matrix(matrix)
+
+        a.cholesky()
+        u = np.triu(a.gather_to_root() if a.processor_layout.comm.Get_rank() == 0
+                    else np.zeros((na, na), dtype=dtype))
+        a.processor_layout.comm.Bcast(u)
+        a.set_data_from_global_matrix(u)
+        product = a.hermitian_multiply(a)
+        for index in range(0, na, 7):
+            assert(np.allclose(product.get_column(index), matrix[:, index]))
+
+        a.invert_triangular()
+        for index in range(0, na, 7):
+            assert(np.allclose(np.dot(u, a.get_column(index)),
+                               np.eye(na)[:, index]))
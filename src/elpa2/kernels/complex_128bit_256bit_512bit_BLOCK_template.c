@@ -100,6 +100,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef BLOCK4
+#define PREFIX quad
+#define BLOCK 4
+#endif
+
 #ifdef BLOCK2
 #define PREFIX double
 #define BLOCK 2
@@ -146,10 +151,12 @@
 #ifdef DOUBLE_PRECISION_COMPLEX
 #define ONE 1.0
 #define MONE -1.0
+#define ZERO 0.0
 #endif
 #ifdef SINGLE_PRECISION_COMPLEX
 #define ONE 1.0f
 #define MONE -1.0f
+#define ZERO 0.0f
 #endif
 
 #if VEC_SET == SSE_128
@@ -551,6 +558,365 @@
 #endif
 
 
+#ifdef BLOCK4
+/*
+ * With 4 Householder vectors the kernel is not unrolled by hand over the
+ * rows of Q as for the smaller blocks. Instead one call works on rows SIMD
+ * vectors of rows (rows is a constant from 1 to 3 after inlining) and the 4
+ * vectors are expanded by the QUAD_ macros. Vector j (counted from 1) starts
+ * in column BLOCK-j of Q, its element e (counted from 1, the first element
+ * is 1 and stored as tau) lies in column e+BLOCK-1-j.
+ *
+ * The first and the last BLOCK columns, in which not all vectors are
+ * present, are peeled: which vectors touch a column is known at compile
+ * time, provided nb >= BLOCK. Smaller nb take the loops with the checks.
+ *
+ * The real and the imaginary part of the Householder elements are applied
+ * with one FMA each: the products Q conj(v_j) are accumulated as
+ * a_j = sum h_real q and b_j = sum h_imag q, which are combined once at the
+ * end, and the update Q + w_j v_j^T uses w_j and i*w_j.
+ */
+
+#if VEC_SET == AVX2_256
+#ifdef DOUBLE_PRECISION_COMPLEX
+#define QUAD_FMA(a, b, c) _mm256_fmadd_pd(a, b, c)
+#endif
+#ifdef SINGLE_PRECISION_COMPLEX
+#define QUAD_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#endif
+#endif /* VEC_SET == AVX2_256 */
+
+#if VEC_SET == AVX_512
+#ifdef DOUBLE_PRECISION_COMPLEX
+#define QUAD_FMA(a, b, c) _mm512_fmadd_pd(a, b, c)
+#endif
+#ifdef SINGLE_PRECISION_COMPLEX
+#define QUAD_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#endif
+#endif /* VEC_SET == AVX_512 */
+
+#if VEC_SET == AVX2_256 || VEC_SET == AVX_512
+#define QUAD_MUL(a, b) _SIMD_MUL(a, b)
+#define QUAD_SHUFFLE(a) _SIMD_SHUFFLE(a, a, _SHUFFLE_VAL)
+// even elements a-b, odd elements a+b
+#define QUAD_ADDSUB(a, b) _SIMD_FMADDSUB(one, a, b)
+// even elements a+b, odd elements a-b
+#define QUAD_SUBADD(a, b) _SIMD_FMSUBADD(one, a, b)
+#endif /* VEC_SET == AVX2_256 || VEC_SET == AVX_512 */
+
+#if VEC_SET == SVE_512 || VEC_SET == SVE_256 || VEC_SET == SVE_128
+#ifdef DOUBLE_PRECISION_COMPLEX
+#define QUAD_FMA(a, b, c) svmad_f64_z(svptrue_b64(), a, b, c)
+#define QUAD_MUL(a, b) svmul_f64_z(svptrue_b64(), a, b)
+#define QUAD_ADD(a, b) svadd_f64_z(svptrue_b64(), a, b)
+#endif
+#ifdef SINGLE_PRECISION_COMPLEX
+#define QUAD_FMA(a, b, c) svmad_f32_z(svptrue_b32(), a, b, c)
+#define QUAD_MUL(a, b) svmul_f32_z(svptrue_b32(), a, b)
+#define QUAD_ADD(a, b) svadd_f32_z(svptrue_b32(), a, b)
+#endif
+#define QUAD_SHUFFLE(a) _SHUFFLE(a)
+#define QUAD_ADDSUB(a, b) QUAD_ADD(a, QUAD_MUL(minus_switch_sign, b))
+#define QUAD_SUBADD(a, b) QUAD_ADD(a, QUAD_MUL(switch_sign, b))
+#endif /* VEC_SET == SVE_512 || VEC_SET == SVE_256 || VEC_SET == SVE_128 */
+
+#define QUAD_FOR_VECTORS(X) X(1) X(2) X(3) X(4)
+#define QUAD_FOR_VECTORS_IN(X, c) X(1, c) X(2, c) X(3, c) X(4, c)
+
+// element of vector j in column c of Q
+#define QUAD_ELEMENT(j) (c+(j)-BLOCK+1)
+#define QUAD_H_REAL(j) (QUAD_ELEMENT(j) == 1 ? ONE : hh_dbl[2*(((j)-1)*ldh+QUAD_ELEMENT(j)-1)])
+#define QUAD_H_IMAG(j) (QUAD_ELEMENT(j) == 1 ? ZERO : hh_dbl[2*(((j)-1)*ldh+QUAD_ELEMENT(j)-1)+1])
+#define QUAD_IN_COLUMN(j) (QUAD_ELEMENT(j) >= 1 && QUAD_ELEMENT(j) <= nb)
+
+// vector j in the peeled column k of the front (column k) and of the back (column nb+k)
+#define QUAD_IN_FRONT(j, k) ((j)+(k) >= BLOCK)
+#define QUAD_H_REAL_FRONT(j, k) ((j)+(k) == BLOCK ? ONE : hh_dbl[2*(((j)-1)*ldh+(k)+(j)-BLOCK)])
+#define QUAD_H_IMAG_FRONT(j, k) ((j)+(k) == BLOCK ? ZERO : hh_dbl[2*(((j)-1)*ldh+(k)+(j)-BLOCK)+1])
+#define QUAD_IN_BACK(j, k) ((j)+(k) < BLOCK)
+#define QUAD_H_REAL_BACK(j, k) hh_dbl[2*(((j)-1)*ldh+nb+(k)+(j)-BLOCK)]
+#define QUAD_H_IMAG_BACK(j, k) hh_dbl[2*(((j)-1)*ldh+nb+(k)+(j)-BLOCK)+1]
+
+// i*x
+#define QUAD_TIMES_I(x) QUAD_ADDSUB(zero, QUAD_SHUFFLE(x))
+
+#define QUAD_LOAD_Q(c) \
+   q1 = _LOAD(&q_dbl[2*(c)*ldq]); \
+   if (rows >= 2) q2 = _LOAD(&q_dbl[2*(c)*ldq+offset]); \
+   if (rows >= 3) q3 = _LOAD(&q_dbl[2*(c)*ldq+2*offset]);
+
+#define QUAD_STORE_Q(c) \
+   _STORE(&q_dbl[2*(c)*ldq], q1); \
+   if (rows >= 2) _STORE(&q_dbl[2*(c)*ldq+offset], q2); \
+   if (rows >= 3) _STORE(&q_dbl[2*(c)*ldq+2*offset], q3);
+
+// a_j + i b_j = Q conj(v_j), kept in w_j and iw_j
+#define QUAD_ZERO(j) \
+   w##j##_1 = zero; \
+   w##j##_2 = zero; \
+   w##j##_3 = zero; \
+   iw##j##_1 = zero; \
+   iw##j##_2 = zero; \
+   iw##j##_3 = zero;
+
+#define QUAD_DOT_H(j) \
+   w##j##_1 = QUAD_FMA(h_real, q1, w##j##_1); \
+   iw##j##_1 = QUAD_FMA(h_imag, q1, iw##j##_1); \
+   if (rows >= 2) \
+     { \
+       w##j##_2 = QUAD_FMA(h_real, q2, w##j##_2); \
+       iw##j##_2 = QUAD_FMA(h_imag, q2, iw##j##_2); \
+     } \
+   if (rows >= 3) \
+     { \
+       w##j##_3 = QUAD_FMA(h_real, q3, w##j##_3); \
+       iw##j##_3 = QUAD_FMA(h_imag, q3, iw##j##_3); \
+     }
+
+#define QUAD_DOT(j) \
+   h_real = _SIMD_SET1(hh_dbl[2*(((j)-1)*ldh+QUAD_ELEMENT(j)-1)]); \
+   h_imag = _SIMD_SET1(hh_dbl[2*(((j)-1)*ldh+QUAD_ELEMENT(j)-1)+1]); \
+   QUAD_DOT_H(j)
+
+#define QUAD_DOT_EDGE(j) \
+   if (QUAD_IN_COLUMN(j)) \
+     { \
+       h_real = _SIMD_SET1(QUAD_H_REAL(j)); \
+       h_imag = _SIMD_SET1(QUAD_H_IMAG(j)); \
+       QUAD_DOT_H(j) \
+     }
+
+#define QUAD_DOT_FRONT_VECTOR(j, k) \
+   if (QUAD_IN_FRONT(j, k)) \
+     { \
+       h_real = _SIMD_SET1(QUAD_H_REAL_FRONT(j, k)); \
+       h_imag = _SIMD_SET1(QUAD_H_IMAG_FRONT(j, k)); \
+       QUAD_DOT_H(j) \
+     }
+
+#define QUAD_DOT_BACK_VECTOR(j, k) \
+   if (QUAD_IN_BACK(j, k)) \
+     { \
+       h_real = _SIMD_SET1(QUAD_H_REAL_BACK(j, k)); \
+       h_imag = _SIMD_SET1(QUAD_H_IMAG_BACK(j, k)); \
+       QUAD_DOT_H(j) \
+     }
+
+#define QUAD_DOT_FRONT(k) \
+   QUAD_LOAD_Q(k) \
+   QUAD_FOR_VECTORS_IN(QUAD_DOT_FRONT_VECTOR, k)
+
+#define QUAD_DOT_BACK(k) \
+   QUAD_LOAD_Q(nb+(k)) \
+   QUAD_FOR_VECTORS_IN(QUAD_DOT_BACK_VECTOR, k)
+
+// w_j = -tau_j (Q conj(v_j) + sum_{i<j} s_ij w_i), iw_j = i*w_j
+#define QUAD_TAU(j) \
+   z = -hh[((j)-1)*ldh]; \
+   h_real = _SIMD_SET1(creal(z)); \
+   h_imag = _SIMD_SET1(cimag(z)); \
+   w##j##_1 = QUAD_SUBADD(w##j##_1, QUAD_SHUFFLE(iw##j##_1)); \
+   iw##j##_1 = QUAD_TIMES_I(w##j##_1); \
+   w##j##_1 = QUAD_FMA(h_imag, iw##j##_1, QUAD_MUL(h_real, w##j##_1)); \
+   if (rows >= 2) \
+     { \
+       w##j##_2 = QUAD_SUBADD(w##j##_2, QUAD_SHUFFLE(iw##j##_2)); \
+       iw##j##_2 = QUAD_TIMES_I(w##j##_2); \
+       w##j##_2 = QUAD_FMA(h_imag, iw##j##_2, QUAD_MUL(h_real, w##j##_2)); \
+     } \
+   if (rows >= 3) \
+     { \
+       w##j##_3 = QUAD_SUBADD(w##j##_3, QUAD_SHUFFLE(iw##j##_3)); \
+       iw##j##_3 = QUAD_TIMES_I(w##j##_3); \
+       w##j##_3 = QUAD_FMA(h_imag, iw##j##_3, QUAD_MUL(h_real, w##j##_3)); \
+     }
+
+#define QUAD_RANK(j, i) \
+   z = -hh[((j)-1)*ldh] * scalarprods[((j)-1)*((j)-2)/2+(i)-1]; \
+   h_real = _SIMD_SET1(creal(z)); \
+   h_imag = _SIMD_SET1(cimag(z)); \
+   w##j##_1 = QUAD_FMA(h_real, w##i##_1, w##j##_1); \
+   w##j##_1 = QUAD_FMA(h_imag, iw##i##_1, w##j##_1); \
+   if (rows >= 2) \
+     { \
+       w##j##_2 = QUAD_FMA(h_real, w##i##_2, w##j##_2); \
+       w##j##_2 = QUAD_FMA(h_imag, iw##i##_2, w##j##_2); \
+     } \
+   if (rows >= 3) \
+     { \
+       w##j##_3 = QUAD_FMA(h_real, w##i##_3, w##j##_3); \
+       w##j##_3 = QUAD_FMA(h_imag, iw##i##_3, w##j##_3); \
+     }
+
+#define QUAD_FINISH(j) \
+   iw##j##_1 = QUAD_TIMES_I(w##j##_1); \
+   if (rows >= 2) iw##j##_2 = QUAD_TIMES_I(w##j##_2); \
+   if (rows >= 3) iw##j##_3 = QUAD_TIMES_I(w##j##_3);
+
+// Q = Q + sum_j w_j v_j^T
+#define QUAD_UPDATE_H(j) \
+   q1 = QUAD_FMA(h_real, w##j##_1, q1); \
+   q1 = QUAD_FMA(h_imag, iw##j##_1, q1); \
+   if (rows >= 2) \
+     { \
+       q2 = QUAD_FMA(h_real, w##j##_2, q2); \
+       q2 = QUAD_FMA(h_imag, iw##j##_2, q2); \
+     } \
+   if (rows >= 3) \
+     { \
+       q3 = QUAD_FMA(h_real, w##j##_3, q3); \
+       q3 = QUAD_FMA(h_imag, iw##j##_3, q3); \
+     }
+
+#define QUAD_UPDATE(j) \
+   h_real = _SIMD_SET1(hh_dbl[2*(((j)-1)*ldh+QUAD_ELEMENT(j)-1)]); \
+   h_imag = _SIMD_SET1(hh_dbl[2*(((j)-1)*ldh+QUAD_ELEMENT(j)-1)+1]); \
+   QUAD_UPDATE_H(j)
+
+#define QUAD_UPDATE_EDGE(j) \
+   if (QUAD_IN_COLUMN(j)) \
+     { \
+       h_real = _SIMD_SET1(QUAD_H_REAL(j)); \
+       h_imag = _SIMD_SET1(QUAD_H_IMAG(j)); \
+       QUAD_UPDATE_H(j) \
+     }
+
+#define QUAD_UPDATE_FRONT_VECTOR(j, k) \
+   if (QUAD_IN_FRONT(j, k)) \
+     { \
+       h_real = _SIMD_SET1(QUAD_H_REAL_FRONT(j, k)); \
+       h_imag = _SIMD_SET1(QUAD_H_IMAG_FRONT(j, k)); \
+       QUAD_UPDATE_H(j) \
+     }
+
+#define QUAD_UPDATE_BACK_VECTOR(j, k) \
+   if (QUAD_IN_BACK(j, k)) \
+     { \
+       h_real = _SIMD_SET1(QUAD_H_REAL_BACK(j, k)); \
+       h_imag = _SIMD_SET1(QUAD_H_IMAG_BACK(j, k)); \
+       QUAD_UPDATE_H(j) \
+     }
+
+#define QUAD_UPDATE_FRONT(k) \
+   QUAD_LOAD_Q(k) \
+   QUAD_FOR_VECTORS_IN(QUAD_UPDATE_FRONT_VECTOR, k) \
+   QUAD_STORE_Q(k)
+
+#define QUAD_UPDATE_BACK(k) \
+   QUAD_LOAD_Q(nb+(k)) \
+   QUAD_FOR_VECTORS_IN(QUAD_UPDATE_BACK_VECTOR, k) \
+   QUAD_STORE_Q(nb+(k))
+
+/*
+ * Kernel that applies 4 Householder vectors to rows*offset/2 rows of Q,
+ * scalarprods holds the products s_ij of the vectors i < j at
+ * (j-1)*(j-2)/2+i-1
+ */
+static __forceinline void CONCAT_6ARGS(hh_trafo_complex_kernel_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int nb, int ldq,
+	int ldh, DATA_TYPE_PTR scalarprods, const int rows)
+{
+   DATA_TYPE_REAL_PTR q_dbl = (DATA_TYPE_REAL_PTR)q;
+   DATA_TYPE_REAL_PTR hh_dbl = (DATA_TYPE_REAL_PTR)hh;
+   DATA_TYPE z;
+   __SIMD_DATATYPE q1, q2, q3, h_real, h_imag, zero;
+   __SIMD_DATATYPE w1_1, w2_1, w3_1, w4_1, iw1_1, iw2_1, iw3_1, iw4_1;
+   __SIMD_DATATYPE w1_2, w2_2, w3_2, w4_2, iw1_2, iw2_2, iw3_2, iw4_2;
+   __SIMD_DATATYPE w1_3, w2_3, w3_3, w4_3, iw1_3, iw2_3, iw3_3, iw4_3;
+   int c;
+
+#if VEC_SET == AVX2_256 || VEC_SET == AVX_512
+   __SIMD_DATATYPE one = _SIMD_SET1(ONE);
+#endif
+#if VEC_SET == SVE_512 || VEC_SET == SVE_256 || VEC_SET == SVE_128
+   __SIMD_DATATYPE switch_sign, minus_switch_sign;
+   DATA_TYPE_REAL switch_sign_dbl[offset];
+
+   for (c = 0; c < offset; c += 2)
+     {
+       switch_sign_dbl[c]   =  ONE;
+       switch_sign_dbl[c+1] = MONE;
+     }
+   switch_sign = _LOAD(&switch_sign_dbl[0]);
+   minus_switch_sign = QUAD_MUL(_SIMD_SET1(MONE), switch_sign);
+#endif
+   zero = _SIMD_SET1(ZERO);
+
+   QUAD_FOR_VECTORS(QUAD_ZERO)
+
+   if (nb >= BLOCK)
+     {
+       // the first columns, in which not all vectors start
+       QUAD_DOT_FRONT(0)
+       QUAD_DOT_FRONT(1)
+       QUAD_DOT_FRONT(2)
+       QUAD_DOT_FRONT(3)
+
+       for (c = BLOCK; c < nb; c++)
+         {
+           QUAD_LOAD_Q(c)
+           QUAD_FOR_VECTORS(QUAD_DOT)
+         }
+
+       // the last columns, in which not all vectors end
+       QUAD_DOT_BACK(0)
+       QUAD_DOT_BACK(1)
+       QUAD_DOT_BACK(2)
+     }
+   else
+     {
+       for (c = 0; c < nb+BLOCK-1; c++)
+         {
+           QUAD_LOAD_Q(c)
+           QUAD_FOR_VECTORS(QUAD_DOT_EDGE)
+         }
+     }
+
+   QUAD_TAU(1)
+   QUAD_FINISH(1)
+   QUAD_TAU(2)
+   QUAD_RANK(2, 1)
+   QUAD_FINISH(2)
+   QUAD_TAU(3)
+   QUAD_RANK(3, 1)
+   QUAD_RANK(3, 2)
+   QUAD_FINISH(3)
+   QUAD_TAU(4)
+   QUAD_RANK(4, 1)
+   QUAD_RANK(4, 2)
+   QUAD_RANK(4, 3)
+   QUAD_FINISH(4)
+
+   if (nb >= BLOCK)
+     {
+       QUAD_UPDATE_FRONT(0)
+       QUAD_UPDATE_FRONT(1)
+       QUAD_UPDATE_FRONT(2)
+       QUAD_UPDATE_FRONT(3)
+
+       for (c = BLOCK; c < nb; c++)
+         {
+           QUAD_LOAD_Q(c)
+           QUAD_FOR_VECTORS(QUAD_UPDATE)
+           QUAD_STORE_Q(c)
+         }
+
+       QUAD_UPDATE_BACK(0)
+       QUAD_UPDATE_BACK(1)
+       QUAD_UPDATE_BACK(2)
+     }
+   else
+     {
+       for (c = 0; c < nb+BLOCK-1; c++)
+         {
+           QUAD_LOAD_Q(c)
+           QUAD_FOR_VECTORS(QUAD_UPDATE_EDGE)
+           QUAD_STORE_Q(c)
+         }
+     }
+}
+
+#else /* BLOCK4 */
+
 //Forward declaration
 
 #if VEC_SET == SSE_128 || VEC_SET == NEON_ARCH64_128 || VEC_SET == SVE_128
@@ -800,6 +1166,7 @@ static __forceinline void CONCAT_8ARGS(hh_trafo_complex_kernel_,ROW_LENGTH,_,SIM
                                        ,int ldh, DATA_TYPE s);
 #endif
 
+#endif /* BLOCK4 */
 
 /*
 !f>#ifdef HAVE_SSE_INTRINSICS
@@ -1343,11 +1710,161 @@ static __forceinline void CONCAT_8ARGS(hh_trafo_complex_kernel_,ROW_LENGTH,_,SIM
 */
 
 
+/*
+!f>#if defined(HAVE_AVX2)
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_AVX2_4hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_AVX2_4hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_double_complex)     :: q(*)
+!f>     type(c_ptr), value                    :: q
+!f>     complex(kind=c_double_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#if defined(HAVE_AVX2)
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_AVX2_4hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_AVX2_4hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_float_complex)     :: q(*)
+!f>     type(c_ptr), value                   :: q
+!f>     complex(kind=c_float_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#if defined(HAVE_AVX512)
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_AVX512_4hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_AVX512_4hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_double_complex)     :: q(*)
+!f>     type(c_ptr), value                    :: q
+!f>     complex(kind=c_double_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#if defined(HAVE_AVX512)
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_AVX512_4hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_AVX512_4hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_float_complex)     :: q(*)
+!f>     type(c_ptr), value                   :: q
+!f>     complex(kind=c_float_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#ifdef HAVE_SVE128
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_SVE128_4hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_SVE128_4hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_double_complex)     :: q(*)
+!f>     type(c_ptr), value                    :: q
+!f>     complex(kind=c_double_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#ifdef HAVE_SVE128
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_SVE128_4hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_SVE128_4hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_float_complex)     :: q(*)
+!f>     type(c_ptr), value                   :: q
+!f>     complex(kind=c_float_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#if defined(HAVE_SVE256)
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_SVE256_4hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_SVE256_4hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_double_complex)     :: q(*)
+!f>     type(c_ptr), value                    :: q
+!f>     complex(kind=c_double_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#if defined(HAVE_SVE256)
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_SVE256_4hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_SVE256_4hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_float_complex)     :: q(*)
+!f>     type(c_ptr), value                   :: q
+!f>     complex(kind=c_float_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#if defined(HAVE_SVE512)
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_SVE512_4hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_SVE512_4hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_double_complex)     :: q(*)
+!f>     type(c_ptr), value                    :: q
+!f>     complex(kind=c_double_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+/*
+!f>#if defined(HAVE_SVE512)
+!f> interface
+!f>   subroutine quad_hh_trafo_complex_SVE512_4hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_complex_SVE512_4hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     ! complex(kind=c_float_complex)     :: q(*)
+!f>     type(c_ptr), value                   :: q
+!f>     complex(kind=c_float_complex)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
 void CONCAT_7ARGS(PREFIX,_hh_trafo_complex_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int* pnb, int* pnq, int* pldq
 #ifdef BLOCK1
 		  )
 #endif
-#ifdef BLOCK2
+#if defined(BLOCK2) || defined(BLOCK4)
                   ,int* pldh)
 #endif
 {
@@ -1410,6 +1927,83 @@ void CONCAT_7ARGS(PREFIX,_hh_trafo_complex_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (D
      }
 #endif
 
+#ifdef BLOCK4
+     int ldh = *pldh;
+     int l;
+     DATA_TYPE_REAL_PTR hh_dbl = (DATA_TYPE_REAL_PTR)hh;
+
+     // s_kj = v_k^T conj(v_j) for the vectors k < j, vector j starts j-k columns before vector k
+     DATA_TYPE scalarprods[6];
+
+     // Element i of vector j meets element i-j+k of vector k. The real and
+     // the imaginary parts of the 6 sums are accumulated side by side, each
+     // in BLOCK partial sums over consecutive i, such that the loop over the
+     // partial sums is vectorized and no sum waits for the previous product.
+#define QUAD_PAIRS(X) \
+     X(2, 1) X(3, 2) X(4, 3) \
+     X(3, 1) X(4, 2) \
+     X(4, 1)
+
+#define QUAD_S_DECLARE(j, k) \
+     DATA_TYPE_REAL s_##k##_##j##_real[BLOCK], s_##k##_##j##_imag[BLOCK]; \
+     for (l = 0; l < BLOCK; l++) \
+     { \
+       s_##k##_##j##_real[l] = ZERO; \
+       s_##k##_##j##_imag[l] = ZERO; \
+     } \
+     if ((j)-(k) < nb) \
+     { \
+       s_##k##_##j##_real[0] = hh_dbl[2*(ldh*((j)-1)+(j)-(k))]; \
+       s_##k##_##j##_imag[0] = -hh_dbl[2*(ldh*((j)-1)+(j)-(k))+1]; \
+     }
+
+// (a_real + i a_imag) * conj(b_real + i b_imag) for a = v_k(i-j+k), b = v_j(i)
+#define QUAD_S_ADD_LANE(j, k, l) \
+     s_##k##_##j##_real[l] += hh_dbl[2*(ldh*((k)-1)+i+(l)-(j)+(k))] * hh_dbl[2*(ldh*((j)-1)+i+(l))] \
+                            + hh_dbl[2*(ldh*((k)-1)+i+(l)-(j)+(k))+1] * hh_dbl[2*(ldh*((j)-1)+i+(l))+1]; \
+     s_##k##_##j##_imag[l] += hh_dbl[2*(ldh*((k)-1)+i+(l)-(j)+(k))+1] * hh_dbl[2*(ldh*((j)-1)+i+(l))] \
+                            - hh_dbl[2*(ldh*((k)-1)+i+(l)-(j)+(k))] * hh_dbl[2*(ldh*((j)-1)+i+(l))+1];
+
+#define QUAD_S_ADD(j, k) \
+     QUAD_S_ADD_LANE(j, k, 0)
+
+#define QUAD_S_ADD_BLOCK(j, k) \
+     for (l = 0; l < BLOCK; l++) \
+     { \
+       QUAD_S_ADD_LANE(j, k, l) \
+     }
+
+#define QUAD_S_HEAD(j, k) \
+     for (i = (j)-(k)+1; i < BLOCK && i < nb; i++) \
+     { \
+       QUAD_S_ADD(j, k) \
+     }
+
+#define QUAD_S_STORE(j, k) \
+     scalarprods[((j)-1)*((j)-2)/2+(k)-1] = ZERO; \
+     for (l = 0; l < BLOCK; l++) \
+     { \
+       scalarprods[((j)-1)*((j)-2)/2+(k)-1] += s_##k##_##j##_real[l] + I*s_##k##_##j##_imag[l]; \
+     }
+
+     QUAD_PAIRS(QUAD_S_DECLARE)
+
+     // the first columns, in which not all pairs meet
+     QUAD_PAIRS(QUAD_S_HEAD)
+
+     for (i = BLOCK; i + BLOCK <= nb; i += BLOCK)
+     {
+       QUAD_PAIRS(QUAD_S_ADD_BLOCK)
+     }
+
+     for (; i < nb; i++)
+     {
+       QUAD_PAIRS(QUAD_S_ADD)
+     }
+
+     QUAD_PAIRS(QUAD_S_STORE)
+#endif
+
      worked_on = 0;
 
 #ifdef BLOCK1
@@ -1829,6 +2423,45 @@ void CONCAT_7ARGS(PREFIX,_hh_trafo_complex_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (D
 
 #endif /* BLOCK2 */
 
+#ifdef BLOCK4
+#if VEC_SET == AVX2_256
+    // with 16 registers some of the products of two vectors of rows are
+    // spilled, which is still faster than one vector of rows
+#define ROWS 2
+#else
+    // with 32 vector registers the products of three vectors of rows are kept in registers
+#define ROWS 3
+#endif
+#undef ROW_LENGTH
+#define ROW_LENGTH (ROWS*offset/2)
+
+#if ROWS > 2
+    // the last four vectors of rows are done as 2+2 rather than as 3+1
+    for (i = 0; i < nq-ROW_LENGTH+1 && nq-i != 2*offset; i += ROW_LENGTH)
+#else
+    for (i = 0; i < nq-ROW_LENGTH+1; i += ROW_LENGTH)
+#endif
+    {
+        CONCAT_6ARGS(hh_trafo_complex_kernel_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (&q[i], hh, nb, ldq, ldh, scalarprods, ROWS);
+        worked_on += ROW_LENGTH;
+    }
+
+#if ROWS > 2
+    for (; i < nq-offset+1; i += offset)
+    {
+        CONCAT_6ARGS(hh_trafo_complex_kernel_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (&q[i], hh, nb, ldq, ldh, scalarprods, 2);
+        worked_on += offset;
+    }
+#endif
+
+    for (; i < nq; i += offset/2)
+    {
+        CONCAT_6ARGS(hh_trafo_complex_kernel_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (&q[i], hh, nb, ldq, ldh, scalarprods, 1);
+        worked_on += offset/2;
+    }
+#undef ROWS
+#endif /* BLOCK4 */
+
 #ifdef WITH_DEBUG
     if (worked_on != nq)
     {
@@ -1839,6 +2472,7 @@ void CONCAT_7ARGS(PREFIX,_hh_trafo_complex_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (D
 
 }
 
+#ifndef BLOCK4
 #if VEC_SET == SSE_128 || VEC_SET == NEON_ARCH64_128 || VEC_SET == SVE_128
 #undef ROW_LENGTH
 #ifdef DOUBLE_PRECISION_COMPLEX
@@ -9909,3 +10543,4 @@ static __forceinline void CONCAT_8ARGS(hh_trafo_complex_kernel_,ROW_LENGTH,_,SIM
 #endif /* BLOCK2 */
 
 }
+#endif /* BLOCK4 */
@@ -105,6 +105,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef BLOCK8
+#define PREFIX octa
+#define BLOCK 8
+#endif
+
 #ifdef BLOCK6
 #define PREFIX hexa
 #define BLOCK 6
@@ -161,11 +166,13 @@
 #endif
 
 #ifdef DOUBLE_PRECISION_REAL
+#define ZERO 0.0
 #define ONE 1.0
 #define MONE -1.0
 #endif
 
 #ifdef SINGLE_PRECISION_REAL
+#define ZERO 0.0f
 #define ONE 1.0f
 #define MONE -1.0f
 #endif
@@ -514,6 +521,255 @@
 //#define _XOR(a, b) _SIMD_XOR(a, b)
 #endif
 
+#ifdef BLOCK8
+/*
+ * With 8 Householder vectors the kernel is not unrolled by hand over the
+ * rows of Q as for the smaller blocks. Instead one call works on rows SIMD
+ * vectors of rows (rows is a constant from 1 to 3 after inlining) and the 8
+ * vectors are expanded by the OCTA_ macros. Vector j (counted from 1) starts
+ * in column BLOCK-j of Q, its element e (counted from 1, the first element
+ * is 1 and stored as tau) lies in column e+BLOCK-1-j.
+ *
+ * The first and the last BLOCK columns, in which not all vectors are
+ * present, are peeled: which vectors touch a column is known at compile
+ * time, provided nb >= BLOCK. Smaller nb take the loops with the checks.
+ */
+
+#ifdef __ELPA_USE_FMA__
+#define OCTA_FMA(a, b, c) _SIMD_FMA(a, b, c)
+#define OCTA_NFMA(a, b, c) _SIMD_NFMA(a, b, c)
+#else
+#define OCTA_FMA(a, b, c) _SIMD_ADD( ADDITIONAL_ARGUMENT c, _SIMD_MUL( ADDITIONAL_ARGUMENT a, b))
+#define OCTA_NFMA(a, b, c) _SIMD_SUB( ADDITIONAL_ARGUMENT c, _SIMD_MUL( ADDITIONAL_ARGUMENT a, b))
+#endif
+
+#define OCTA_FOR_VECTORS(X) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8)
+#define OCTA_FOR_VECTORS_IN(X, c) X(1, c) X(2, c) X(3, c) X(4, c) X(5, c) X(6, c) X(7, c) X(8, c)
+#define OCTA_FOR_EDGE_COLUMNS(X) X(0) X(1) X(2) X(3) X(4) X(5) X(6)
+
+// element of vector j in column c of Q
+#define OCTA_ELEMENT(j) (c+(j)-BLOCK+1)
+#define OCTA_H(j) (OCTA_ELEMENT(j) == 1 ? ONE : hh[((j)-1)*ldh+OCTA_ELEMENT(j)-1])
+#define OCTA_IN_COLUMN(j) (OCTA_ELEMENT(j) >= 1 && OCTA_ELEMENT(j) <= nb)
+
+// vector j in the peeled column k of the front (column k) and of the back (column nb+k)
+#define OCTA_IN_FRONT(j, k) ((j)+(k) >= BLOCK)
+#define OCTA_H_FRONT(j, k) ((j)+(k) == BLOCK ? ONE : hh[((j)-1)*ldh+(k)+(j)-BLOCK])
+#define OCTA_IN_BACK(j, k) ((j)+(k) < BLOCK)
+#define OCTA_H_BACK(j, k) hh[((j)-1)*ldh+nb+(k)+(j)-BLOCK]
+
+#define OCTA_LOAD_Q(c) \
+   q1 = _LOAD(&q[(c)*ldq]); \
+   if (rows >= 2) q2 = _LOAD(&q[(c)*ldq+offset]); \
+   if (rows >= 3) q3 = _LOAD(&q[(c)*ldq+2*offset]);
+
+#define OCTA_STORE_Q(c) \
+   _STORE(&q[(c)*ldq], q1); \
+   if (rows >= 2) _STORE(&q[(c)*ldq+offset], q2); \
+   if (rows >= 3) _STORE(&q[(c)*ldq+2*offset], q3);
+
+// w_j = Q v_j
+#define OCTA_ZERO(j) \
+   w##j##_1 = _SIMD_SET1(ZERO); \
+   w##j##_2 = w##j##_1; \
+   w##j##_3 = w##j##_1;
+
+#define OCTA_DOT_H(j) \
+   w##j##_1 = OCTA_FMA(q1, h, w##j##_1); \
+   if (rows >= 2) w##j##_2 = OCTA_FMA(q2, h, w##j##_2); \
+   if (rows >= 3) w##j##_3 = OCTA_FMA(q3, h, w##j##_3);
+
+#define OCTA_DOT(j) \
+   h = _SIMD_SET1(hh[((j)-1)*ldh+OCTA_ELEMENT(j)-1]); \
+   OCTA_DOT_H(j)
+
+#define OCTA_DOT_EDGE(j) \
+   if (OCTA_IN_COLUMN(j)) \
+     { \
+       h = _SIMD_SET1(OCTA_H(j)); \
+       OCTA_DOT_H(j) \
+     }
+
+#define OCTA_DOT_FRONT_VECTOR(j, k) \
+   if (OCTA_IN_FRONT(j, k)) \
+     { \
+       h = _SIMD_SET1(OCTA_H_FRONT(j, k)); \
+       OCTA_DOT_H(j) \
+     }
+
+#define OCTA_DOT_BACK_VECTOR(j, k) \
+   if (OCTA_IN_BACK(j, k)) \
+     { \
+       h = _SIMD_SET1(OCTA_H_BACK(j, k)); \
+       OCTA_DOT_H(j) \
+     }
+
+#define OCTA_DOT_FRONT(k) \
+   OCTA_LOAD_Q(k) \
+   OCTA_FOR_VECTORS_IN(OCTA_DOT_FRONT_VECTOR, k)
+
+#define OCTA_DOT_BACK(k) \
+   OCTA_LOAD_Q(nb+(k)) \
+   OCTA_FOR_VECTORS_IN(OCTA_DOT_BACK_VECTOR, k)
+
+// w_j = tau_j w_j - sum_{i<j} tau_j s_ij w_i
+#define OCTA_TAU(j) \
+   h = _SIMD_SET1(hh[((j)-1)*ldh]); \
+   w##j##_1 = _SIMD_MUL( ADDITIONAL_ARGUMENT w##j##_1, h); \
+   if (rows >= 2) w##j##_2 = _SIMD_MUL( ADDITIONAL_ARGUMENT w##j##_2, h); \
+   if (rows >= 3) w##j##_3 = _SIMD_MUL( ADDITIONAL_ARGUMENT w##j##_3, h);
+
+#define OCTA_RANK(j, i) \
+   h = _SIMD_SET1(hh[((j)-1)*ldh] * scalarprods[((j)-1)*((j)-2)/2+(i)-1]); \
+   w##j##_1 = OCTA_NFMA(w##i##_1, h, w##j##_1); \
+   if (rows >= 2) w##j##_2 = OCTA_NFMA(w##i##_2, h, w##j##_2); \
+   if (rows >= 3) w##j##_3 = OCTA_NFMA(w##i##_3, h, w##j##_3);
+
+// Q = Q - sum_j w_j v_j^T
+#define OCTA_UPDATE_H(j) \
+   q1 = OCTA_NFMA(w##j##_1, h, q1); \
+   if (rows >= 2) q2 = OCTA_NFMA(w##j##_2, h, q2); \
+   if (rows >= 3) q3 = OCTA_NFMA(w##j##_3, h, q3);
+
+#define OCTA_UPDATE(j) \
+   h = _SIMD_SET1(hh[((j)-1)*ldh+OCTA_ELEMENT(j)-1]); \
+   OCTA_UPDATE_H(j)
+
+#define OCTA_UPDATE_EDGE(j) \
+   if (OCTA_IN_COLUMN(j)) \
+     { \
+       h = _SIMD_SET1(OCTA_H(j)); \
+       OCTA_UPDATE_H(j) \
+     }
+
+#define OCTA_UPDATE_FRONT_VECTOR(j, k) \
+   if (OCTA_IN_FRONT(j, k)) \
+     { \
+       h = _SIMD_SET1(OCTA_H_FRONT(j, k)); \
+       OCTA_UPDATE_H(j) \
+     }
+
+#define OCTA_UPDATE_BACK_VECTOR(j, k) \
+   if (OCTA_IN_BACK(j, k)) \
+     { \
+       h = _SIMD_SET1(OCTA_H_BACK(j, k)); \
+       OCTA_UPDATE_H(j) \
+     }
+
+#define OCTA_UPDATE_FRONT(k) \
+   OCTA_LOAD_Q(k) \
+   OCTA_FOR_VECTORS_IN(OCTA_UPDATE_FRONT_VECTOR, k) \
+   OCTA_STORE_Q(k)
+
+#define OCTA_UPDATE_BACK(k) \
+   OCTA_LOAD_Q(nb+(k)) \
+   OCTA_FOR_VECTORS_IN(OCTA_UPDATE_BACK_VECTOR, k) \
+   OCTA_STORE_Q(nb+(k))
+
+/*
+ * Kernel that applies 8 Householder vectors to rows*offset rows of Q,
+ * scalarprods holds the products s_ij of the vectors i < j at
+ * (j-1)*(j-2)/2+i-1
+ */
+__forceinline void CONCAT_6ARGS(hh_trafo_kernel_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int nb, int ldq, int ldh,
+	DATA_TYPE_PTR scalarprods, const int rows)
+{
+   __SIMD_DATATYPE q1, q2, q3, h;
+   __SIMD_DATATYPE w1_1, w2_1, w3_1, w4_1, w5_1, w6_1, w7_1, w8_1;
+   __SIMD_DATATYPE w1_2, w2_2, w3_2, w4_2, w5_2, w6_2, w7_2, w8_2;
+   __SIMD_DATATYPE w1_3, w2_3, w3_3, w4_3, w5_3, w6_3, w7_3, w8_3;
+   int c;
+
+   OCTA_FOR_VECTORS(OCTA_ZERO)
+
+   if (nb >= BLOCK)
+     {
+       // the first columns, in which not all vectors start
+       OCTA_FOR_EDGE_COLUMNS(OCTA_DOT_FRONT)
+       OCTA_DOT_FRONT(BLOCK-1)
+
+       for (c = BLOCK; c < nb; c++)
+         {
+           OCTA_LOAD_Q(c)
+           OCTA_FOR_VECTORS(OCTA_DOT)
+         }
+
+       // the last columns, in which not all vectors end
+       OCTA_FOR_EDGE_COLUMNS(OCTA_DOT_BACK)
+     }
+   else
+     {
+       for (c = 0; c < nb+BLOCK-1; c++)
+         {
+           OCTA_LOAD_Q(c)
+           OCTA_FOR_VECTORS(OCTA_DOT_EDGE)
+         }
+     }
+
+   OCTA_TAU(1)
+   OCTA_TAU(2)
+   OCTA_RANK(2, 1)
+   OCTA_TAU(3)
+   OCTA_RANK(3, 1)
+   OCTA_RANK(3, 2)
+   OCTA_TAU(4)
+   OCTA_RANK(4, 1)
+   OCTA_RANK(4, 2)
+   OCTA_RANK(4, 3)
+   OCTA_TAU(5)
+   OCTA_RANK(5, 1)
+   OCTA_RANK(5, 2)
+   OCTA_RANK(5, 3)
+   OCTA_RANK(5, 4)
+   OCTA_TAU(6)
+   OCTA_RANK(6, 1)
+   OCTA_RANK(6, 2)
+   OCTA_RANK(6, 3)
+   OCTA_RANK(6, 4)
+   OCTA_RANK(6, 5)
+   OCTA_TAU(7)
+   OCTA_RANK(7, 1)
+   OCTA_RANK(7, 2)
+   OCTA_RANK(7, 3)
+   OCTA_RANK(7, 4)
+   OCTA_RANK(7, 5)
+   OCTA_RANK(7, 6)
+   OCTA_TAU(8)
+   OCTA_RANK(8, 1)
+   OCTA_RANK(8, 2)
+   OCTA_RANK(8, 3)
+   OCTA_RANK(8, 4)
+   OCTA_RANK(8, 5)
+   OCTA_RANK(8, 6)
+   OCTA_RANK(8, 7)
+
+   if (nb >= BLOCK)
+     {
+       OCTA_FOR_EDGE_COLUMNS(OCTA_UPDATE_FRONT)
+       OCTA_UPDATE_FRONT(BLOCK-1)
+
+       for (c = BLOCK; c < nb; c++)
+         {
+           OCTA_LOAD_Q(c)
+           OCTA_FOR_VECTORS(OCTA_UPDATE)
+           OCTA_STORE_Q(c)
+         }
+
+       OCTA_FOR_EDGE_COLUMNS(OCTA_UPDATE_BACK)
+     }
+   else
+     {
+       for (c = 0; c < nb+BLOCK-1; c++)
+         {
+           OCTA_LOAD_Q(c)
+           OCTA_FOR_VECTORS(OCTA_UPDATE_EDGE)
+           OCTA_STORE_Q(c)
+         }
+     }
+}
+
+#else /* BLOCK8 */
+
 #if VEC_SET == SSE_128 || VEC_SET == SPARC64_SSE || VEC_SET == VSX_SSE ||  VEC_SET == NEON_ARCH64_128 || VEC_SET == SVE_128
 //Forward declaration
 #ifdef DOUBLE_PRECISION_REAL
@@ -777,6 +1033,8 @@ __forceinline void CONCAT_8ARGS(hh_trafo_kernel_,ROW_LENGTH,_,SIMD_SET,_,BLOCK,h
 	DATA_TYPE_PTR scalarprods);
 #endif
 
+#endif /* BLOCK8 */
+
 void CONCAT_7ARGS(PREFIX,_hh_trafo_real_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int* pnb, int* pnq, int* pldq, int* pldh);
 
 /*
@@ -1603,6 +1861,137 @@ void CONCAT_7ARGS(PREFIX,_hh_trafo_real_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA
 !f>#endif
 */
 
+/*
+!f>#if defined(HAVE_AVX2)
+!f> interface
+!f>   subroutine octa_hh_trafo_real_AVX2_8hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_AVX2_8hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_double)     :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_AVX2)
+!f> interface
+!f>   subroutine octa_hh_trafo_real_AVX2_8hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_AVX2_8hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_float)      :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_AVX512)
+!f> interface
+!f>   subroutine octa_hh_trafo_real_AVX512_8hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_AVX512_8hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_double)     :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_AVX512)
+!f> interface
+!f>   subroutine octa_hh_trafo_real_AVX512_8hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_AVX512_8hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_float)      :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#ifdef HAVE_SVE128
+!f> interface
+!f>   subroutine octa_hh_trafo_real_SVE128_8hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_SVE128_8hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_double)     :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#ifdef HAVE_SVE128
+!f> interface
+!f>   subroutine octa_hh_trafo_real_SVE128_8hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_SVE128_8hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_float)      :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_SVE256)
+!f> interface
+!f>   subroutine octa_hh_trafo_real_SVE256_8hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_SVE256_8hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_double)     :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_SVE256)
+!f> interface
+!f>   subroutine octa_hh_trafo_real_SVE256_8hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_SVE256_8hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_float)      :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_SVE512)
+!f> interface
+!f>   subroutine octa_hh_trafo_real_SVE512_8hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_SVE512_8hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_double)     :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_SVE512)
+!f> interface
+!f>   subroutine octa_hh_trafo_real_SVE512_8hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="octa_hh_trafo_real_SVE512_8hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_float)      :: hh(pnb,8)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
 void CONCAT_7ARGS(PREFIX,_hh_trafo_real_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int* pnb, int* pnq, int* pldq, int* pldh)
 {
   int i;
@@ -1766,6 +2155,65 @@ void CONCAT_7ARGS(PREFIX,_hh_trafo_real_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA
 
 #endif /* BLOCK6 */
 
+#ifdef BLOCK8
+  // calculating scalar products to compute
+  // 8 householder vectors simultaneously
+  DATA_TYPE scalarprods[28];
+  int l;
+
+  // Element i of vector j meets element i-j+k of vector k. The 28 sums are
+  // accumulated side by side, each in BLOCK partial sums over consecutive
+  // i, such that the loop over the partial sums is vectorized and no sum
+  // waits for the previous product; the partial sums are added at the end.
+#define OCTA_PAIRS(X) \
+   X(2, 1) X(3, 2) X(4, 3) X(5, 4) X(6, 5) X(7, 6) X(8, 7) \
+   X(3, 1) X(4, 2) X(5, 3) X(6, 4) X(7, 5) X(8, 6) \
+   X(4, 1) X(5, 2) X(6, 3) X(7, 4) X(8, 5) \
+   X(5, 1) X(6, 2) X(7, 3) X(8, 4) \
+   X(6, 1) X(7, 2) X(8, 3) \
+   X(7, 1) X(8, 2) \
+   X(8, 1)
+
+#define OCTA_S_DECLARE(j, k) \
+   DATA_TYPE s_##k##_##j[BLOCK]; \
+   for (l = 0; l < BLOCK; l++) s_##k##_##j[l] = ZERO; \
+   s_##k##_##j[0] = ((j)-(k) < nb) ? hh[(ldh*((j)-1))+(j)-(k)] : ZERO;
+
+#define OCTA_S_ADD(j, k) \
+   s_##k##_##j[0] += hh[(ldh*((k)-1))+i-(j)+(k)] * hh[(ldh*((j)-1))+i];
+
+#define OCTA_S_ADD_BLOCK(j, k) \
+   for (l = 0; l < BLOCK; l++) s_##k##_##j[l] += hh[(ldh*((k)-1))+i+l-(j)+(k)] * hh[(ldh*((j)-1))+i+l];
+
+#define OCTA_S_HEAD(j, k) \
+   for (i = (j)-(k)+1; i < BLOCK && i < nb; i++) \
+     { \
+       OCTA_S_ADD(j, k) \
+     }
+
+#define OCTA_S_STORE(j, k) \
+   scalarprods[((j)-1)*((j)-2)/2+(k)-1] = ZERO; \
+   for (l = 0; l < BLOCK; l++) scalarprods[((j)-1)*((j)-2)/2+(k)-1] += s_##k##_##j[l];
+
+  OCTA_PAIRS(OCTA_S_DECLARE)
+
+  // the first columns, in which not all pairs meet
+  OCTA_PAIRS(OCTA_S_HEAD)
+
+  for (i = BLOCK; i + BLOCK <= nb; i += BLOCK)
+    {
+      OCTA_PAIRS(OCTA_S_ADD_BLOCK)
+    }
+
+  for (; i < nb; i++)
+    {
+      OCTA_PAIRS(OCTA_S_ADD)
+    }
+
+  OCTA_PAIRS(OCTA_S_STORE)
+#endif /* BLOCK8 */
+
+#if defined(BLOCK2) || defined(BLOCK4) || defined(BLOCK6)
 #if VEC_SET == SSE_128 || VEC_SET == AVX_256 || VEC_SET == AVX2_256 || VEC_SET == AVX_512
   #pragma ivdep
 #endif
@@ -1809,6 +2257,7 @@ void CONCAT_7ARGS(PREFIX,_hh_trafo_real_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA
 #endif /* BLOCK6 */
 
     }
+#endif /* BLOCK2 || BLOCK4 || BLOCK6 */
 
   // Production level kernel calls with padding
 #ifdef BLOCK2
@@ -2290,6 +2739,47 @@ void CONCAT_7ARGS(PREFIX,_hh_trafo_real_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA
 
 #endif /* BLOCK6 */
 
+#ifdef BLOCK8
+
+#undef ROW_LENGTH
+#if VEC_SET == AVX_512 || VEC_SET == SVE_512 || VEC_SET == SVE_256 || VEC_SET == SVE_128
+  // with 32 vector registers the dot products of three vectors of rows are kept in registers
+#define ROWS 3
+#else
+  // with 16 registers some of the dot products of two vectors of rows are
+  // spilled, which is still faster than one vector of rows
+#define ROWS 2
+#endif
+#define ROW_LENGTH (ROWS*offset)
+
+#if ROWS > 2
+  // the last four vectors of rows are done as 2+2 rather than as 3+1
+  for (i = 0; i + ROW_LENGTH <= nq && nq - i != 4*offset; i += ROW_LENGTH)
+#else
+  for (i = 0; i + ROW_LENGTH <= nq; i += ROW_LENGTH)
+#endif
+    {
+      CONCAT_6ARGS(hh_trafo_kernel_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (&q[i], hh, nb, ldq, ldh, scalarprods, ROWS);
+      worked_on += ROW_LENGTH;
+    }
+
+#if ROWS > 2
+  for (; i + 2*offset <= nq; i += 2*offset)
+    {
+      CONCAT_6ARGS(hh_trafo_kernel_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (&q[i], hh, nb, ldq, ldh, scalarprods, 2);
+      worked_on += 2*offset;
+    }
+#endif
+
+  for (; i < nq; i += offset)
+    {
+      CONCAT_6ARGS(hh_trafo_kernel_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (&q[i], hh, nb, ldq, ldh, scalarprods, 1);
+      worked_on += offset;
+    }
+#undef ROWS
+
+#endif /* BLOCK8 */
+
 #ifdef WITH_DEBUG
   if (worked_on != nq)
     {
@@ -2299,6 +2789,7 @@ void CONCAT_7ARGS(PREFIX,_hh_trafo_real_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA
 #endif
 }
 
+#ifndef BLOCK8
 #undef ROW_LENGTH
 #if  VEC_SET == SSE_128 || VEC_SET == SPARC64_SSE || VEC_SET == VSX_SSE || VEC_SET == NEON_ARCH64_128 || VEC_SET == SVE_128
 #ifdef DOUBLE_PRECISION_REAL
@@ -17963,6 +18454,7 @@ __forceinline void CONCAT_8ARGS(hh_trafo_kernel_,ROW_LENGTH,_,SIMD_SET,_,BLOCK,h
 #endif /* BLOCK6 */
 
 }
+#endif /* BLOCK8 */
 
 #undef SIMD_SET
 #undef OFFSET
@@ -0,0 +1,407 @@
+//    This file is part of ELPA.
+//
+//    The ELPA library was originally created by the ELPA consortium,
+//    consisting of the following organizations:
+//
+//    - Max Planck Computing and Data Facility (MPCDF), formerly known as
+//      Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+//    - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+//      Informatik,
+//    - Technische Universität München, Lehrstuhl für Informatik mit
+//      Schwerpunkt Wissenschaftliches Rechnen ,
+//    - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+//    - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+//      Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+//      and
+//    - IBM Deutschland GmbH
+//
+//
+//    This particular source code file contains additions, changes and
+//    enhancements authored by Intel Corporation which is not part of
+//    the ELPA consortium.
+//
+//    More information can be found here:
+//    http://elpa.mpcdf.mpg.de/
+//
+//    ELPA is free software: you can redistribute it and/or modify
+//    it under the terms of the version 3 of the license of the
+//    GNU Lesser General Public License as published by the Free
+//    Software Foundation.
+//
+//    ELPA is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with ELPA. If not, see <http://www.gnu.org/licenses/>
+//
+//    ELPA reflects a substantial effort on the part of the original
+//    ELPA consortium, and we ask you to respect the spirit of the
+//    license that we chose: i.e., please contribute any changes you
+//    may have back to the original ELPA library distribution, and keep
+//    any derivatives of ELPA under the same license that we chose for
+//    the original distribution, the GNU Lesser General Public License.
+//
+
+/*
+ * Real Householder kernels written with the vector extensions of GCC and
+ * Clang instead of the intrinsics of one instruction set. The compiler maps
+ * the vectors to the SIMD instructions enabled by CFLAGS, such that these
+ * kernels can be built for every architecture. The vectors have
+ * VECTOR_KERNEL_BYTES bytes (configure option --with-vector-kernel-width,
+ * otherwise derived from the target) and BLOCK Householder vectors are
+ * applied at once.
+ */
+
+#include "config-f90.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONCAT_7ARGS(a, b, c, d, e, f, g) CONCAT2_7ARGS(a, b, c, d, e, f, g)
+#define CONCAT2_7ARGS(a, b, c, d, e, f, g) a ## b ## c ## d ## e ## f ## g
+
+#define CONCAT_4ARGS(a, b, c, d) CONCAT2_4ARGS(a, b, c, d)
+#define CONCAT2_4ARGS(a, b, c, d) a ## b ## c ## d
+
+#ifdef BLOCK6
+#define PREFIX hexa
+#define BLOCK 6
+#endif
+
+#ifdef BLOCK4
+#define PREFIX quad
+#define BLOCK 4
+#endif
+
+#ifdef BLOCK2
+#define PREFIX double
+#define BLOCK 2
+#endif
+
+#define SIMD_SET VECTOR
+
+#ifndef VECTOR_KERNEL_BYTES
+#if defined(__AVX512F__) || (defined(__ARM_FEATURE_SVE_BITS) && __ARM_FEATURE_SVE_BITS >= 512)
+#define VECTOR_KERNEL_BYTES 64
+#elif defined(__AVX__) || (defined(__ARM_FEATURE_SVE_BITS) && __ARM_FEATURE_SVE_BITS >= 256)
+#define VECTOR_KERNEL_BYTES 32
+#else
+#define VECTOR_KERNEL_BYTES 16
+#endif
+#endif
+
+#ifdef DOUBLE_PRECISION_REAL
+#define WORD_LENGTH double
+#define DATA_TYPE double
+#define DATA_TYPE_PTR double*
+#define ZERO 0.0
+#define ONE 1.0
+#endif
+
+#ifdef SINGLE_PRECISION_REAL
+#define WORD_LENGTH single
+#define DATA_TYPE float
+#define DATA_TYPE_PTR float*
+#define ZERO 0.0f
+#define ONE 1.0f
+#endif
+
+typedef DATA_TYPE __SIMD_DATATYPE __attribute__((vector_size(VECTOR_KERNEL_BYTES)));
+
+// number of elements of one vector and number of vectors of rows per kernel call
+#define offset ((int) (VECTOR_KERNEL_BYTES/sizeof(DATA_TYPE)))
+#define ROWS 2
+
+#if defined(__clang__)
+#define _UNROLL _Pragma("unroll")
+#else
+#define _UNROLL _Pragma("GCC unroll 8")
+#endif
+
+#define __forceinline __attribute__((always_inline)) static inline
+
+// Q is only aligned to its elements if the stripe width is not a multiple of the vectors
+__forceinline __SIMD_DATATYPE _LOAD(const DATA_TYPE *p)
+{
+   __SIMD_DATATYPE a;
+   memcpy(&a, p, sizeof(a));
+   return a;
+}
+
+__forceinline void _STORE(DATA_TYPE *p, __SIMD_DATATYPE a)
+{
+   memcpy(p, &a, sizeof(a));
+}
+
+// a - 0 is a, unlike a + 0 for a = -0, and is not computed
+#define _SIMD_SET1(a) (((DATA_TYPE) (a)) - (__SIMD_DATATYPE) {})
+
+/*
+ * Element e (counted from 0, the first element is 1 and stored as tau) of
+ * vector j (counted from 0) lies in column c = e+BLOCK-1-j of Q. The
+ * columns in which some vectors start or end are passed with edge set.
+ */
+__forceinline void CONCAT_4ARGS(hh_trafo_kernel_dot_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int nb, int ldq, int ldh,
+	int c, int edge, int rows, __SIMD_DATATYPE w[BLOCK][ROWS])
+{
+   __SIMD_DATATYPE x[ROWS], h;
+   int j, r, e;
+
+   _UNROLL
+   for (r = 0; r < rows; r++)
+     {
+       x[r] = _LOAD(&q[c*ldq+r*offset]);
+     }
+
+   _UNROLL
+   for (j = 0; j < BLOCK; j++)
+     {
+       e = c+j-BLOCK+1;
+       if (edge && (e < 0 || e >= nb)) continue;
+       h = _SIMD_SET1((edge && e == 0) ? ONE : hh[j*ldh+e]);
+       _UNROLL
+       for (r = 0; r < rows; r++)
+         {
+           w[j][r] = w[j][r] + x[r] * h;
+         }
+     }
+}
+
+__forceinline void CONCAT_4ARGS(hh_trafo_kernel_update_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int nb, int ldq, int ldh,
+	int c, int edge, int rows, __SIMD_DATATYPE w[BLOCK][ROWS])
+{
+   __SIMD_DATATYPE x[ROWS], h;
+   int j, r, e;
+
+   _UNROLL
+   for (r = 0; r < rows; r++)
+     {
+       x[r] = _LOAD(&q[c*ldq+r*offset]);
+     }
+
+   _UNROLL
+   for (j = 0; j < BLOCK; j++)
+     {
+       e = c+j-BLOCK+1;
+       if (edge && (e < 0 || e >= nb)) continue;
+       h = _SIMD_SET1((edge && e == 0) ? ONE : hh[j*ldh+e]);
+       _UNROLL
+       for (r = 0; r < rows; r++)
+         {
+           x[r] = x[r] - w[j][r] * h;
+         }
+     }
+
+   _UNROLL
+   for (r = 0; r < rows; r++)
+     {
+       _STORE(&q[c*ldq+r*offset], x[r]);
+     }
+}
+
+/*
+ * Kernel that applies BLOCK Householder vectors to rows*offset rows of Q,
+ * scalarprods holds the products s_kj of the vectors k < j at j*(j-1)/2+k
+ */
+__forceinline void CONCAT_4ARGS(hh_trafo_kernel_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int nb, int ldq, int ldh,
+	DATA_TYPE_PTR scalarprods, int rows)
+{
+   __SIMD_DATATYPE w[BLOCK][ROWS], h;
+   int c, j, k, r;
+
+   _UNROLL
+   for (j = 0; j < BLOCK; j++)
+     {
+       _UNROLL
+       for (r = 0; r < rows; r++)
+         {
+           w[j][r] = _SIMD_SET1(ZERO);
+         }
+     }
+
+   // w_j = Q v_j
+   for (c = 0; c < BLOCK; c++)
+     {
+       CONCAT_4ARGS(hh_trafo_kernel_dot_,BLOCK,hv_,WORD_LENGTH) (q, hh, nb, ldq, ldh, c, 1, rows, w);
+     }
+   for (c = BLOCK; c < nb; c++)
+     {
+       CONCAT_4ARGS(hh_trafo_kernel_dot_,BLOCK,hv_,WORD_LENGTH) (q, hh, nb, ldq, ldh, c, 0, rows, w);
+     }
+   for (c = (nb > BLOCK ? nb : BLOCK); c < nb+BLOCK-1; c++)
+     {
+       CONCAT_4ARGS(hh_trafo_kernel_dot_,BLOCK,hv_,WORD_LENGTH) (q, hh, nb, ldq, ldh, c, 1, rows, w);
+     }
+
+   // w_j = tau_j w_j - sum_{k<j} tau_j s_kj w_k
+   _UNROLL
+   for (j = 0; j < BLOCK; j++)
+     {
+       h = _SIMD_SET1(hh[j*ldh]);
+       _UNROLL
+       for (r = 0; r < rows; r++)
+         {
+           w[j][r] = w[j][r] * h;
+         }
+       _UNROLL
+       for (k = 0; k < j; k++)
+         {
+           h = _SIMD_SET1(hh[j*ldh] * scalarprods[j*(j-1)/2+k]);
+           _UNROLL
+           for (r = 0; r < rows; r++)
+             {
+               w[j][r] = w[j][r] - w[k][r] * h;
+             }
+         }
+     }
+
+   // Q = Q - sum_j w_j v_j^T
+   for (c = 0; c < BLOCK; c++)
+     {
+       CONCAT_4ARGS(hh_trafo_kernel_update_,BLOCK,hv_,WORD_LENGTH) (q, hh, nb, ldq, ldh, c, 1, rows, w);
+     }
+   for (c = BLOCK; c < nb; c++)
+     {
+       CONCAT_4ARGS(hh_trafo_kernel_update_,BLOCK,hv_,WORD_LENGTH) (q, hh, nb, ldq, ldh, c, 0, rows, w);
+     }
+   for (c = (nb > BLOCK ? nb : BLOCK); c < nb+BLOCK-1; c++)
+     {
+       CONCAT_4ARGS(hh_trafo_kernel_update_,BLOCK,hv_,WORD_LENGTH) (q, hh, nb, ldq, ldh, c, 1, rows, w);
+     }
+}
+
+/*
+!f>#if defined(HAVE_VECTOR_EXTENSIONS)
+!f> interface
+!f>   subroutine double_hh_trafo_real_VECTOR_2hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="double_hh_trafo_real_VECTOR_2hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_double)     :: hh(pnb,2)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_VECTOR_EXTENSIONS)
+!f> interface
+!f>   subroutine double_hh_trafo_real_VECTOR_2hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="double_hh_trafo_real_VECTOR_2hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_float)      :: hh(pnb,2)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_VECTOR_EXTENSIONS)
+!f> interface
+!f>   subroutine quad_hh_trafo_real_VECTOR_4hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_real_VECTOR_4hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_double)     :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_VECTOR_EXTENSIONS)
+!f> interface
+!f>   subroutine quad_hh_trafo_real_VECTOR_4hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="quad_hh_trafo_real_VECTOR_4hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_float)      :: hh(pnb,4)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_VECTOR_EXTENSIONS)
+!f> interface
+!f>   subroutine hexa_hh_trafo_real_VECTOR_6hv_double(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="hexa_hh_trafo_real_VECTOR_6hv_double")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_double)     :: hh(pnb,6)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+/*
+!f>#if defined(HAVE_VECTOR_EXTENSIONS)
+!f> interface
+!f>   subroutine hexa_hh_trafo_real_VECTOR_6hv_single(q, hh, pnb, pnq, pldq, pldh) &
+!f>                             bind(C, name="hexa_hh_trafo_real_VECTOR_6hv_single")
+!f>     use, intrinsic :: iso_c_binding
+!f>     integer(kind=c_int)     :: pnb, pnq, pldq, pldh
+!f>     type(c_ptr), value      :: q
+!f>     real(kind=c_float)      :: hh(pnb,6)
+!f>   end subroutine
+!f> end interface
+!f>#endif
+*/
+
+void CONCAT_7ARGS(PREFIX,_hh_trafo_real_,SIMD_SET,_,BLOCK,hv_,WORD_LENGTH) (DATA_TYPE_PTR q, DATA_TYPE_PTR hh, int* pnb, int* pnq, int* pldq, int* pldh)
+{
+  int i, j, k, d;
+  int nb = *pnb;
+  int nq = *pldq;
+  int ldq = *pldq;
+  int ldh = *pldh;
+
+  // calculating the scalar products s_kj = v_k^T v_j of the vectors k < j,
+  // vector j starts j-k columns before vector k
+  DATA_TYPE scalarprods[BLOCK*(BLOCK-1)/2];
+
+  for (j = 1; j < BLOCK; j++)
+    {
+      for (k = 0; k < j; k++)
+        {
+          d = j-k;
+          scalarprods[j*(j-1)/2+k] = (d < nb) ? hh[(ldh*j)+d] : ZERO;
+          for (i = 1; i < nb-d; i++)
+            {
+              scalarprods[j*(j-1)/2+k] += hh[(ldh*k)+i] * hh[(ldh*j)+i+d];
+            }
+        }
+    }
+
+  for (i = 0; i + ROWS*offset <= nq; i += ROWS*offset)
+    {
+      CONCAT_4ARGS(hh_trafo_kernel_,BLOCK,hv_,WORD_LENGTH) (&q[i], hh, nb, ldq, ldh, scalarprods, ROWS);
+    }
+
+  for (; i + offset <= nq; i += offset)
+    {
+      CONCAT_4ARGS(hh_trafo_kernel_,BLOCK,hv_,WORD_LENGTH) (&q[i], hh, nb, ldq, ldh, scalarprods, 1);
+    }
+
+  // the last rows, which do not fill a vector, are transformed in a copy
+  if (i < nq)
+    {
+      DATA_TYPE rest[(nb+BLOCK-1)*offset];
+      int c;
+
+      memset(rest, 0, sizeof(rest));
+      for (c = 0; c < nb+BLOCK-1; c++)
+        {
+          memcpy(&rest[c*offset], &q[c*ldq+i], (nq-i)*sizeof(DATA_TYPE));
+        }
+      CONCAT_4ARGS(hh_trafo_kernel_,BLOCK,hv_,WORD_LENGTH) (rest, hh, nb, offset, ldh, scalarprods, 1);
+      for (c = 0; c < nb+BLOCK-1; c++)
+        {
+          memcpy(&q[c*ldq+i], &rest[c*offset], (nq-i)*sizeof(DATA_TYPE));
+        }
+    }
+}
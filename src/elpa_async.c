@@ -0,0 +1,248 @@
+//    This file is part of ELPA.
+//
+//    The ELPA library was originally created by the ELPA consortium,
+//    consisting of the following organizations:
+//
+//    - Max Planck Computing and Data Facility (MPCDF), formerly known as
+//      Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+//    - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+//      Informatik,
+//    - Technische Universität München, Lehrstuhl für Informatik mit
+//      Schwerpunkt Wissenschaftliches Rechnen ,
+//    - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+//    - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+//      Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+//      and
+//    - IBM Deutschland GmbH
+//
+//    More information can be found here:
+//    http://elpa.mpcdf.mpg.de/
+//
+//    ELPA is free software: you can redistribute it and/or modify
+//    it under the terms of the version 3 of the license of the
+//    GNU Lesser General Public License as published by the Free
+//    Software Foundation.
+//
+//    ELPA is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with ELPA. If not, see <http://www.gnu.org/licenses/>
+//
+//    ELPA reflects a substantial effort on the part of the original
+//    ELPA consortium, and we ask you to respect the spirit of the
+//    license that we chose: i.e., please contribute any changes you
+//    may have back to the original ELPA library distribution, and keep
+//    any derivatives of ELPA under the same license that we chose for
+//    the original distribution, the GNU Lesser General Public License.
+//
+
+// Asynchronous solves.
+//
+// Every asynchronous solve runs the ordinary solver in its own POSIX thread.
+// Cancellation is cooperative: the solvers ask elpa_async_cancel_requested()
+// at the end of each step and set a bit of their success flag, which is
+// or-reduced over all processes, such that all processes stop after the same
+// step. An error of any process takes precedence over the cancellation.
+
+#define _XOPEN_SOURCE 700
+#include "config-f90.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+#include <elpa/elpa.h>
+
+/* stack of the solver thread if the stack size of the process is unlimited */
+#define ASYNC_DEFAULT_STACK_SIZE ((size_t) 1 << 30)
+
+struct elpa_request_struct {
+	pthread_t thread;
+	void (*solve)(struct elpa_request_struct *request);
+	elpa_t handle;
+	void *a;
+	void *ev;
+	void *q;
+	int error;
+	atomic_int finished;
+	atomic_int cancel;
+	atomic_int cancelled;
+};
+
+/* the request of the solve running in this thread, NULL in all other threads */
+static _Thread_local struct elpa_request_struct *current_request = NULL;
+
+#define ASYNC_SOLVERS(X) \
+	X(d, double, double) \
+	X(f, float, float) \
+	X(dc, double_complex, double) \
+	X(fc, float_complex, float)
+
+#define ASYNC_SOLVE_FUNCTIONS(SUFFIX, MATH_TYPE, REAL_TYPE) \
+	static void solve_eigenvectors_##SUFFIX(struct elpa_request_struct *request) { \
+		elpa_eigenvectors_a_h_a_##SUFFIX(request->handle, (MATH_TYPE *) request->a, (REAL_TYPE *) request->ev, \
+		                                 (MATH_TYPE *) request->q, &request->error); \
+	} \
+	static void solve_eigenvalues_##SUFFIX(struct elpa_request_struct *request) { \
+		elpa_eigenvalues_a_h_a_##SUFFIX(request->handle, (MATH_TYPE *) request->a, (REAL_TYPE *) request->ev, \
+		                                &request->error); \
+	}
+ASYNC_SOLVERS(ASYNC_SOLVE_FUNCTIONS)
+#undef ASYNC_SOLVE_FUNCTIONS
+
+static void *async_thread(void *arg) {
+	struct elpa_request_struct *request = (struct elpa_request_struct *) arg;
+
+	current_request = request;
+	request->solve(request);
+	current_request = NULL;
+
+	if (atomic_load(&request->cancelled)) {
+		request->error = ELPA_ERROR_CANCELLED;
+	}
+	atomic_store_explicit(&request->finished, 1, memory_order_release);
+	return NULL;
+}
+
+static void async_start(void (*solve)(struct elpa_request_struct *), elpa_t handle, void *a, void *ev, void *q,
+                        elpa_request_t *request, int *error) {
+	struct elpa_request_struct *r;
+	pthread_attr_t attr;
+	struct rlimit limit;
+	size_t stack_size;
+	int status;
+
+	*request = ELPA_REQUEST_NULL;
+
+#ifdef WITH_MPI
+	{
+		int initialized, provided;
+		MPI_Initialized(&initialized);
+		if (initialized) {
+			MPI_Query_thread(&provided);
+			if (provided < MPI_THREAD_SERIALIZED) {
+				*error = ELPA_ERROR_SETUP;
+				return;
+			}
+		}
+	}
+#endif
+
+	r = (struct elpa_request_struct *) calloc(1, sizeof(struct elpa_request_struct));
+	if (r == NULL) {
+		*error = ELPA_ERROR;
+		return;
+	}
+	r->solve = solve;
+	r->handle = handle;
+	r->a = a;
+	r->ev = ev;
+	r->q = q;
+	r->error = ELPA_OK;
+	atomic_init(&r->finished, 0);
+	atomic_init(&r->cancel, 0);
+	atomic_init(&r->cancelled, 0);
+
+	/* the solvers use automatic arrays, give the thread the stack the process would have */
+	stack_size = ASYNC_DEFAULT_STACK_SIZE;
+	if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+		stack_size = (size_t) limit.rlim_cur;
+	}
+
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, stack_size);
+	status = pthread_create(&r->thread, &attr, async_thread, r);
+	pthread_attr_destroy(&attr);
+
+	if (status != 0) {
+		free(r);
+		*error = ELPA_ERROR;
+		return;
+	}
+
+	*request = r;
+	*error = ELPA_OK;
+}
+
+#define ASYNC_START_FUNCTIONS(SUFFIX, MATH_TYPE, REAL_TYPE) \
+	void elpa_eigenvectors_async_a_h_a_##SUFFIX(elpa_t handle, MATH_TYPE *a, REAL_TYPE *ev, MATH_TYPE *q, \
+	                                            elpa_request_t *request, int *error) { \
+		async_start(solve_eigenvectors_##SUFFIX, handle, a, ev, q, request, error); \
+	} \
+	void elpa_eigenvalues_async_a_h_a_##SUFFIX(elpa_t handle, MATH_TYPE *a, REAL_TYPE *ev, \
+	                                           elpa_request_t *request, int *error) { \
+		async_start(solve_eigenvalues_##SUFFIX, handle, a, ev, NULL, request, error); \
+	}
+ASYNC_SOLVERS(ASYNC_START_FUNCTIONS)
+#undef ASYNC_START_FUNCTIONS
+
+static void async_complete(elpa_request_t *request, int *error) {
+	pthread_join((*request)->thread, NULL);
+	*error = (*request)->error;
+	free(*request);
+	*request = ELPA_REQUEST_NULL;
+}
+
+void elpa_test(elpa_request_t *request, int *flag, int *error) {
+	if (*request == ELPA_REQUEST_NULL) {
+		*flag = 1;
+		*error = ELPA_OK;
+		return;
+	}
+	if (!atomic_load_explicit(&(*request)->finished, memory_order_acquire)) {
+		*flag = 0;
+		*error = ELPA_OK;
+		return;
+	}
+	*flag = 1;
+	async_complete(request, error);
+}
+
+void elpa_wait(elpa_request_t *request, int *error) {
+	if (*request == ELPA_REQUEST_NULL) {
+		*error = ELPA_OK;
+		return;
+	}
+	async_complete(request, error);
+}
+
+void elpa_cancel(elpa_request_t request, int *error) {
+	if (request != ELPA_REQUEST_NULL) {
+		atomic_store(&request->cancel, 1);
+	}
+	*error = ELPA_OK;
+}
+
+/*
+ !f> interface
+ !f>   function elpa_async_cancel_requested_c() result(cancel) bind(C, name="elpa_async_cancel_requested")
+ !f>     import c_int
+ !f>     integer(kind=c_int) :: cancel
+ !f>   end function
+ !f> end interface
+ */
+int elpa_async_cancel_requested(void) {
+	if (current_request == NULL) {
+		return 0;
+	}
+	return atomic_load(&current_request->cancel);
+}
+
+/*
+ !f> interface
+ !f>   subroutine elpa_async_set_cancelled_c() bind(C, name="elpa_async_set_cancelled")
+ !f>   end subroutine
+ !f> end interface
+ */
+void elpa_async_set_cancelled(void) {
+	if (current_request != NULL) {
+		atomic_store(&current_request->cancelled, 1);
+	}
+}
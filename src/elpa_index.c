@@ -46,6 +46,8 @@
 //
 //    Authors: L. Huedepohl and A. Marek, MPCDF
 #include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <elpa/elpa.h>
@@ -152,6 +154,22 @@ static int intermediate_bandwidth_cardinality(elpa_index_t index);
 static int intermediate_bandwidth_enumerate(elpa_index_t index, int i);
 static int intermediate_bandwidth_is_valid(elpa_index_t index, int n, int new_value);
 
+static int back_transform_chunk_cardinality(elpa_index_t index);
+static int back_transform_chunk_enumerate(elpa_index_t index, int i);
+static int back_transform_chunk_is_valid(elpa_index_t index, int n, int new_value);
+
+static int dc_fmm_min_size_cardinality(elpa_index_t index);
+static int dc_fmm_min_size_enumerate(elpa_index_t index, int i);
+static int dc_fmm_min_size_is_valid(elpa_index_t index, int n, int new_value);
+
+static int merge_systems_slice_cardinality(elpa_index_t index);
+static int merge_systems_slice_enumerate(elpa_index_t index, int i);
+static int merge_systems_slice_is_valid(elpa_index_t index, int n, int new_value);
+
+static int solve_tridi_leaf_size_cardinality(elpa_index_t index);
+static int solve_tridi_leaf_size_enumerate(elpa_index_t index, int i);
+static int solve_tridi_leaf_size_is_valid(elpa_index_t index, int n, int new_value);
+
 static int cannon_buffer_size_cardinality(elpa_index_t index);
 static int cannon_buffer_size_enumerate(elpa_index_t index, int i);
 static int cannon_buffer_size_is_valid(elpa_index_t index, int n, int new_value);
@@ -164,6 +182,8 @@ static int nvidia_gpu_is_valid(elpa_index_t index, int n, int new_value);
 static int amd_gpu_is_valid(elpa_index_t index, int n, int new_value);
 static int intel_gpu_is_valid(elpa_index_t index, int n, int new_value);
 static int expose_all_sycl_devices_is_valid(elpa_index_t index, int n, int new_value);
+static int reproducible_is_valid(elpa_index_t index, int n, int new_value);
+static int kernel_model_is_valid(elpa_index_t index, int n, int new_value);
 static int nbc_is_valid(elpa_index_t index, int n, int new_value);
 static int nbc_elpa1_is_valid(elpa_index_t index, int n, int new_value);
 static int nbc_elpa2_is_valid(elpa_index_t index, int n, int new_value);
@@ -263,16 +283,27 @@ static const elpa_index_int_entry_t int_entries[] = {
         BOOL_ENTRY("debug", "Emit verbose debugging messages", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0,  ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
         BOOL_ENTRY("print_flops", "Print FLOP rates on task 0", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
         BOOL_ENTRY("measure_performance", "Also measure with flops (via papi) with the timings", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
+        BOOL_ENTRY("trace", "Record the timeline of the timer regions of all threads for elpa_write_trace, also without timings", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
+        BOOL_ENTRY("measure_memory", "Also measure the resident memory, the allocated heap and its peak of each phase with the timings", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
         BOOL_ENTRY("check_pd", "Check eigenvalues to be positive", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
+        BOOL_ENTRY("sterf_for_eigenvalues_only", "Use the QR algorithm (xSTERF) without eigenvector storage for the tridiagonal problem if only eigenvalues are computed", 1, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
+        BOOL_ENTRY("store_householder", "Keep the Householder vectors and the tridiagonal matrix of the ELPA 1stage solver (CPU only) for a later back_transform", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
         BOOL_ENTRY("output_pinning_information", "Print the pinning information", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
         BOOL_ENTRY("cannon_for_generalized", "Whether to use Cannons algorithm for the generalized EVP" , 1, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
         BOOL_ENTRY("pxtrmm_for_generalized", "Whether to use ScaLAPACK's PxTRMM for the generalized EVP", 1, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
+        BOOL_ENTRY("generalized_fused", "Whether to run the generalized EVP as one pipeline, which reuses the matrices a and q as workspace", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
+        BOOL_ENTRY("dc_fmm", "Approximate the eigenvector update of large merges in the divide and conquer solver hierarchically (fast multipole type, CPU only)", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
+        INT_ENTRY("dc_fmm_min_size", "Minimal number of non-deflated eigenvalues of a merge for dc_fmm, default 2048", 2048, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_NONE, \
+                        dc_fmm_min_size_cardinality, dc_fmm_min_size_enumerate, dc_fmm_min_size_is_valid, NULL, PRINT_YES),
+        BOOL_ENTRY("invert_trm_recursive", "Use the divide-and-conquer algorithm (CPU only) in elpa_invert_triangular", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_YES),
 #if defined(THREADING_SUPPORT_CHECK) && defined(ALLOW_THREAD_LIMITING) && !defined(HAVE_SUFFICIENT_MPI_THREADING_SUPPORT)
         BOOL_ENTRY("limit_openmp_threads", "Limit the number if openmp threads to 1", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, 0, ELPA_AUTOTUNE_PART_NONE, PRINT_NO),
 #endif
         BOOL_ENTRY("qr", "Use QR decomposition, only used for ELPA_SOLVER_2STAGE, real case", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_REAL, ELPA_AUTOTUNE_PART_ELPA2, PRINT_YES),
         INT_ENTRY("cannon_buffer_size", "Increasing the buffer size might make it faster, but costs memory", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY,  ELPA_AUTOTUNE_PART_NONE, \
                         cannon_buffer_size_cardinality, cannon_buffer_size_enumerate, cannon_buffer_size_is_valid, NULL, PRINT_YES),
+        INT_ENTRY("reproducible", "Fix the order of all thread and process reductions, such that repeated runs with any number of OpenMP threads give bitwise identical results (CPU only, excludes the nbc_* options and kernel_model). Costs na/tile_size*local_nrows elements of extra memory in the 1stage tridiagonalization, see the timer region reproducible_partial_sums", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ANY, \
+                        cardinality_bool, enumerate_identity, reproducible_is_valid, NULL, PRINT_YES),
         // tunables
 	// 1. non-blocking MPI
         INT_ENTRY("nbc_row_global_gather", "Use non blocking collectives for rows in global_gather", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_SOLVE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ANY, \
@@ -285,6 +316,12 @@ static const elpa_index_int_entry_t int_entries[] = {
                         cardinality_bool, enumerate_identity, nbc_is_valid, NULL, PRINT_YES),
         INT_ENTRY("nbc_row_solve_tridi", "Use non blocking collectives in solve_tridi", 0, ELPA_AUTOTUNE_SOLVE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ANY, \
                         cardinality_bool, enumerate_identity, nbc_is_valid, NULL, PRINT_YES),
+        INT_ENTRY("merge_systems_overlap", "Overlap the ring exchange of the eigenvectors in merge_systems with the computation", 0, ELPA_AUTOTUNE_SOLVE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ANY, \
+                        cardinality_bool, enumerate_identity, valid_bool, NULL, PRINT_YES),
+        INT_ENTRY("merge_systems_slice", "Number of columns per message of the overlapped ring exchange in merge_systems, 0 for one message", 0, ELPA_AUTOTUNE_SOLVE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ANY, \
+                        merge_systems_slice_cardinality, merge_systems_slice_enumerate, merge_systems_slice_is_valid, NULL, PRINT_YES),
+        INT_ENTRY("solve_tridi_leaf_size", "Maximal size of the leaves of divide and conquer with one process row, solved as OpenMP tasks (0: leaves follow the process grid)", 0, ELPA_AUTOTUNE_SOLVE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ANY, \
+                        solve_tridi_leaf_size_cardinality, solve_tridi_leaf_size_enumerate, solve_tridi_leaf_size_is_valid, NULL, PRINT_YES),
         INT_ENTRY("nbc_row_transpose_vectors", "Use non blocking collectives for rows in transpose_vectors", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_TRANSPOSE_VECTORS, ELPA_AUTOTUNE_DOMAIN_ANY,  ELPA_AUTOTUNE_PART_ANY, \
                         cardinality_bool, enumerate_identity, nbc_is_valid, NULL, PRINT_YES),
         INT_ENTRY("nbc_col_transpose_vectors", "Use non blocking collectives for cols in transpose_vectors", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_TRANSPOSE_VECTORS, ELPA_AUTOTUNE_DOMAIN_ANY,  ELPA_AUTOTUNE_PART_ANY, \
@@ -305,6 +342,8 @@ static const elpa_index_int_entry_t int_entries[] = {
                         cardinality_bool, enumerate_identity, nbc_elpa1_is_valid, NULL, PRINT_YES),
         INT_ENTRY("nbc_col_elpa1_tridi_to_full", "Use non blocking collectives for cols in elpa1_tridi_to_full", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA1_AUTOTUNE_TRIDI_TO_FULL, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA1, \
                         cardinality_bool, enumerate_identity, nbc_elpa1_is_valid, NULL, PRINT_YES),
+        INT_ENTRY("trans_ev_lookahead", "Broadcast the next Householder vectors in elpa1_tridi_to_full while the current ones are applied", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA1_AUTOTUNE_TRIDI_TO_FULL, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA1, \
+                        cardinality_bool, enumerate_identity, valid_bool, NULL, PRINT_YES),
         INT_ENTRY("nbc_row_elpa2_full_to_band", "Use non blocking collectives for rows in elpa2_bandred", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA2_AUTOTUNE_FULL_TO_BAND, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA2, \
                         cardinality_bool, enumerate_identity, nbc_elpa2_is_valid, NULL, PRINT_YES),
         INT_ENTRY("nbc_col_elpa2_full_to_band", "Use non blocking collectives for cols in elpa2_bandred", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA2_AUTOTUNE_FULL_TO_BAND, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA2, \
@@ -404,12 +443,16 @@ static const elpa_index_int_entry_t int_entries[] = {
                         min_tile_size_cardinality, min_tile_size_enumerate, min_tile_size_is_valid, NULL, PRINT_YES),
         INT_ENTRY("intermediate_bandwidth", "Specifies the intermediate bandwidth in ELPA2 full->banded step. Must be a multiple of nblk", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA2, \
                         intermediate_bandwidth_cardinality, intermediate_bandwidth_enumerate, intermediate_bandwidth_is_valid, NULL, PRINT_YES),
+        INT_ENTRY("back_transform_chunk", "Number of eigenvector columns the ELPA2 back transformation processes at once, rounded up to a multiple of nblk*num_process_cols; 0 means all columns. Reduces only the work space of the back transformation, q stays in memory (CPU only)", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA2, \
+                        back_transform_chunk_cardinality, back_transform_chunk_enumerate, back_transform_chunk_is_valid, NULL, PRINT_YES),
+        INT_ENTRY("kernel_model", "Choose stripewidth, kernel block size and blocking_in_band_to_full of the ELPA2 back transformation with a cost model of the kernels, which are benchmarked in setup once and stored in ELPA_KERNEL_MODEL_FILE or ~/.elpa_kernel_model (CPU only)", 0, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_NOT_TUNABLE, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA2, \
+                        cardinality_bool, enumerate_identity, kernel_model_is_valid, NULL, PRINT_YES),
 	// EXTENSIVE
 	// 1. BAND_TO_FULL_BLOCKING
         INT_ENTRY("blocking_in_band_to_full", "Loop blocking, default 3", 3, ELPA_AUTOTUNE_EXTENSIVE, ELPA2_AUTOTUNE_BAND_TO_FULL_BLOCKING, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA2, \
                         band_to_full_cardinality, band_to_full_enumerate, band_to_full_is_valid, NULL, PRINT_YES),
 	// 2. max_stored_rows
-        INT_ENTRY("max_stored_rows", "Maximum number of stored rows used in ELPA 1 backtransformation", default_max_stored_rows, ELPA_AUTOTUNE_EXTENSIVE, ELPA1_AUTOTUNE_MAX_STORED_ROWS, ELPA_AUTOTUNE_DOMAIN_ANY,  ELPA_AUTOTUNE_PART_ELPA1, \
+        INT_ENTRY("max_stored_rows", "Maximum number of stored rows used in ELPA 1 backtransformation, 0 for an automatic choice", default_max_stored_rows, ELPA_AUTOTUNE_EXTENSIVE, ELPA1_AUTOTUNE_MAX_STORED_ROWS, ELPA_AUTOTUNE_DOMAIN_ANY,  ELPA_AUTOTUNE_PART_ELPA1, \
                         max_stored_rows_cardinality, max_stored_rows_enumerate, max_stored_rows_is_valid, NULL, PRINT_YES),
 	// 4. BLOCKING in hermitian_multiply
         INT_ENTRY("blocking_in_multiply", "Blocking used in hermitian multiply, default", 31, ELPA_AUTOTUNE_EXTENSIVE, ELPA2_AUTOTUNE_HERMITIAN_MULTIPLY_BLOCKING, ELPA_AUTOTUNE_DOMAIN_ANY, ELPA_AUTOTUNE_PART_ELPA2, \
@@ -452,13 +495,16 @@ static const elpa_index_float_entry_t float_entries[] = {
 
 static const elpa_index_double_entry_t double_entries[] = {
         DOUBLE_ENTRY("thres_pd_double", "Threshold to define ill-conditioning, default 0.00001", 0.00001, PRINT_YES),
+        DOUBLE_ENTRY("dc_fmm_tolerance", "Relative accuracy of the dc_fmm approximation, default 0 (machine precision)", 0.0, PRINT_YES),
 };
 
 void elpa_index_free(elpa_index_t index) {
 #define FREE_OPTION(TYPE, ...) \
         free(index->TYPE##_options.values); \
         free(index->TYPE##_options.is_set); \
-        free(index->TYPE##_options.notified);
+        free(index->TYPE##_options.notified); \
+        free(index->TYPE##_options.forced); \
+        free(index->TYPE##_options.forced_values);
 
         FOR_ALL_TYPES(FREE_OPTION);
 
@@ -470,11 +516,83 @@ static int compar(const void *a, const void *b) {
                       ((elpa_index_int_entry_t *) b)->base.name);
 }
 
+/* The option names are looked up in hash tables (open addressing with linear
+ * probing, at most half full), which map a name to its position in the entries
+ * table. They are built once, on the first lookup, and shared by all instances.
+ * If an option is listed twice, the first entry is found, as with a linear search */
+static uint32_t hash_name(const char *name) {
+        uint32_t hash = 2166136261u;
+        for (; *name; name++) {
+                hash = (hash ^ (unsigned char) *name) * 16777619u;
+        }
+        return hash;
+}
+
+static size_t hash_table_size(size_t nmembers) {
+        size_t size = 16;
+        while (size < 2 * nmembers) {
+                size *= 2;
+        }
+        return size;
+}
+
+/* entry must point to the elpa_index_entry_t base, which is the first member of all entry types */
+#define ENTRY_BASE(entries, stride, i) ((const elpa_index_entry_t *) ((const char *) (entries) + (i) * (stride)))
+
+static int hash_lookup(const int *table, size_t size, const void *entries, size_t stride, const char *name) {
+        size_t slot = hash_name(name) & (size - 1);
+        while (table[slot] >= 0) {
+                if (strcmp(ENTRY_BASE(entries, stride, table[slot])->name, name) == 0) {
+                        return table[slot];
+                }
+                slot = (slot + 1) & (size - 1);
+        }
+        return -1;
+}
+
+static int *hash_table_build(_Atomic(int *) *published, const void *entries, size_t nmembers, size_t stride) {
+        size_t size = hash_table_size(nmembers);
+        int *table = (int *) malloc(size * sizeof(int));
+        int *expected = NULL;
+
+        if (table == NULL) {
+                return NULL;
+        }
+        for (size_t slot = 0; slot < size; slot++) {
+                table[slot] = -1;
+        }
+        for (size_t i = 0; i < nmembers; i++) {
+                const char *name = ENTRY_BASE(entries, stride, i)->name;
+                if (hash_lookup(table, size, entries, stride, name) >= 0) {
+                        continue;
+                }
+                size_t slot = hash_name(name) & (size - 1);
+                while (table[slot] >= 0) {
+                        slot = (slot + 1) & (size - 1);
+                }
+                table[slot] = (int) i;
+        }
+        /* another thread may have been faster */
+        if (!atomic_compare_exchange_strong(published, &expected, table)) {
+                free(table);
+                return expected;
+        }
+        return table;
+}
+
 #define IMPLEMENT_FIND_ENTRY(TYPE, ...) \
+        static _Atomic(int *) TYPE##_hash_table = NULL; \
         static int find_##TYPE##_entry(char *name) { \
+                size_t nmembers = nelements(TYPE##_entries); \
+                int *table = atomic_load_explicit(&TYPE##_hash_table, memory_order_acquire); \
+                if (table == NULL) { \
+                        table = hash_table_build(&TYPE##_hash_table, TYPE##_entries, nmembers, sizeof(elpa_index_##TYPE##_entry_t)); \
+                } \
+                if (table != NULL) { \
+                        return hash_lookup(table, hash_table_size(nmembers), TYPE##_entries, sizeof(elpa_index_##TYPE##_entry_t), name); \
+                } \
                 elpa_index_##TYPE##_entry_t *entry; \
                 elpa_index_##TYPE##_entry_t key = { .base = {.name = name} } ; \
-                size_t nmembers = nelements(TYPE##_entries); \
                 entry = lfind((const void*) &key, (const void *) TYPE##_entries, &nmembers, sizeof(elpa_index_##TYPE##_entry_t), compar); \
                 if (entry) { \
                         return (entry - &TYPE##_entries[0]); \
@@ -529,7 +647,12 @@ FOR_ALL_TYPES(IMPLEMENT_GETENV)
                 int n = find_##TYPE##_entry(name); \
                 if (n >= 0) { \
                         int from_env = 0; \
-                        if (!TYPE##_entries[n].base.once && !TYPE##_entries[n].base.readonly) { \
+                        if (index->env_resolved) { \
+                                if (index->TYPE##_options.forced[n]) { \
+                                        ret = index->TYPE##_options.forced_values[n]; \
+                                        from_env = 1; \
+                                } \
+                        } else if (!TYPE##_entries[n].base.once && !TYPE##_entries[n].base.readonly) { \
                                 from_env = getenv_##TYPE(index, TYPE##_entries[n].base.env_force, NOTIFY_ENV_FORCE, n, &ret, "Option"); \
                         } \
                         if (!from_env) { \
@@ -1001,6 +1124,28 @@ static int complex_kernel_is_valid(elpa_index_t index, int n, int new_value) {
         }
 }
 
+#define COMPILED_CASE(name, value, available, ...) \
+        case value: \
+                return available;
+
+int elpa_2stage_kernel_is_compiled(int is_real, int kernel) {
+        if (is_real) {
+                switch(kernel) {
+                        ELPA_FOR_ALL_2STAGE_REAL_KERNELS(COMPILED_CASE)
+                        default:
+                                return 0;
+                }
+        } else {
+                switch(kernel) {
+                        ELPA_FOR_ALL_2STAGE_COMPLEX_KERNELS(COMPILED_CASE)
+                        default:
+                                return 0;
+                }
+        }
+}
+
+#undef COMPILED_CASE
+
 static const char* elpa_autotune_level_name(int level) {
         switch(level) {
                 ELPA_FOR_ALL_AUTOTUNE_LEVELS(NAME_CASE)
@@ -1087,8 +1232,36 @@ static int expose_all_sycl_devices_is_valid(elpa_index_t index, int n, int new_v
 #endif
 }
 
+static int reproducible_is_valid(elpa_index_t index, int n, int new_value) {
+        if (new_value == 0) {
+                return 1;
+        }
+        if (new_value != 1) {
+                return 0;
+        }
+        // the non-blocking collectives may reduce in a different order
+        for (int i = 0; i < nelements(int_entries); i++) {
+                if (strncmp(int_entries[i].base.name, "nbc_", 4) == 0 && index->int_options.values[i] != 0) {
+                        return 0;
+                }
+        }
+        // the kernel model chooses the kernel and the stripe width with the number of threads
+        return elpa_index_get_int_value(index, "kernel_model", NULL) != 1;
+}
+
+static int kernel_model_is_valid(elpa_index_t index, int n, int new_value) {
+        if (new_value == 0) {
+                return 1;
+        }
+        return new_value == 1 && elpa_index_get_int_value(index, "reproducible", NULL) != 1;
+}
+
+static int nbc_is_reproducible(elpa_index_t index, int new_value) {
+        return new_value == 0 || elpa_index_get_int_value(index, "reproducible", NULL) != 1;
+}
+
 static int nbc_is_valid(elpa_index_t index, int n, int new_value) {
-        return new_value == 0 || new_value == 1;
+        return (new_value == 0 || new_value == 1) && nbc_is_reproducible(index, new_value);
 }
 
 static int verbose_is_valid(elpa_index_t index, int n, int new_value) {
@@ -1098,7 +1271,7 @@ static int verbose_is_valid(elpa_index_t index, int n, int new_value) {
 static int nbc_elpa1_is_valid(elpa_index_t index, int n, int new_value) {
         int solver = elpa_index_get_int_value(index, "solver", NULL);
         if (solver == ELPA_SOLVER_1STAGE) {
-                return ((new_value == 0 ) || (new_value == 1));
+                return ((new_value == 0 ) || (new_value == 1)) && nbc_is_reproducible(index, new_value);
         }
         else {
                 return new_value == 0;
@@ -1108,7 +1281,7 @@ static int nbc_elpa1_is_valid(elpa_index_t index, int n, int new_value) {
 static int nbc_elpa2_is_valid(elpa_index_t index, int n, int new_value) {
         int solver = elpa_index_get_int_value(index, "solver", NULL);
         if (solver == ELPA_SOLVER_2STAGE) {
-                return ((new_value == 0 ) || (new_value == 1));
+                return ((new_value == 0 ) || (new_value == 1)) && nbc_is_reproducible(index, new_value);
         }
         else {
                 return new_value == 0;
@@ -1345,7 +1518,7 @@ static int valid_with_gpu_elpa2(elpa_index_t index, int n, int new_value) {
 }
 
 static int max_stored_rows_cardinality(elpa_index_t index) {
-	return 4;
+	return 5;
 }
 
 static int max_stored_rows_enumerate(elpa_index_t index, int i) {
@@ -1358,6 +1531,8 @@ static int max_stored_rows_enumerate(elpa_index_t index, int i) {
     return 256;
   case 3:
     return 512;
+  case 4:
+    return 0;
   }
 }
 
@@ -1366,7 +1541,7 @@ static int max_stored_rows_is_valid(elpa_index_t index, int n, int new_value) {
         if (solver == ELPA_SOLVER_2STAGE) {
                 return new_value == 15;
         } else {
-                return (15 <= new_value) && (new_value <= 127);
+                return new_value == 0 || ((15 <= new_value) && (new_value <= 127));
         }
 }
 
@@ -1524,6 +1699,76 @@ static int intermediate_bandwidth_is_valid(elpa_index_t index, int n, int new_va
         }
 }
 
+static int back_transform_chunk_cardinality(elpa_index_t index) {
+        return 1;
+}
+
+static int back_transform_chunk_enumerate(elpa_index_t index, int i) {
+        return 0;
+}
+
+static int back_transform_chunk_is_valid(elpa_index_t index, int n, int new_value) {
+        return new_value >= 0;
+}
+
+static int dc_fmm_min_size_cardinality(elpa_index_t index) {
+        return 1;
+}
+
+static int dc_fmm_min_size_enumerate(elpa_index_t index, int i) {
+        return 2048;
+}
+
+static int dc_fmm_min_size_is_valid(elpa_index_t index, int n, int new_value) {
+        return new_value >= 0;
+}
+
+static int merge_systems_slice_cardinality(elpa_index_t index) {
+        return 4;
+}
+
+static int merge_systems_slice_enumerate(elpa_index_t index, int i) {
+        switch(i) {
+          case 0:
+            return 0;
+          case 1:
+            return 32;
+          case 2:
+            return 128;
+          case 3:
+            return 512;
+          default:
+            return 0;
+        }
+}
+
+static int merge_systems_slice_is_valid(elpa_index_t index, int n, int new_value) {
+        return new_value >= 0;
+}
+
+static int solve_tridi_leaf_size_cardinality(elpa_index_t index) {
+        return 4;
+}
+
+static int solve_tridi_leaf_size_enumerate(elpa_index_t index, int i) {
+        switch(i) {
+          case 0:
+            return 0;
+          case 1:
+            return 256;
+          case 2:
+            return 512;
+          case 3:
+            return 1024;
+          default:
+            return 0;
+        }
+}
+
+static int solve_tridi_leaf_size_is_valid(elpa_index_t index, int n, int new_value) {
+        return new_value >= 0;
+}
+
 static int cannon_buffer_size_cardinality(elpa_index_t index) {
         return 2;
 }
@@ -1563,6 +1808,8 @@ elpa_index_t elpa_index_instance() {
         index->TYPE##_options.values = (TYPE*) calloc(nelements(TYPE##_entries), sizeof(TYPE)); \
         index->TYPE##_options.is_set = (int*) calloc(nelements(TYPE##_entries), sizeof(int)); \
         index->TYPE##_options.notified = (int*) calloc(nelements(TYPE##_entries), sizeof(int)); \
+        index->TYPE##_options.forced = (int*) calloc(nelements(TYPE##_entries), sizeof(int)); \
+        index->TYPE##_options.forced_values = (TYPE*) calloc(nelements(TYPE##_entries), sizeof(TYPE)); \
         for (int n = 0; n < nelements(TYPE##_entries); n++) { \
                 TYPE default_value = TYPE##_entries[n].default_value; \
                 if (!TYPE##_entries[n].base.once && !TYPE##_entries[n].base.readonly) { \
@@ -1576,6 +1823,21 @@ elpa_index_t elpa_index_instance() {
         return index;
 }
 
+void elpa_index_resolve_environment(elpa_index_t index) {
+#define RESOLVE_ENV_FORCE(TYPE, ...) \
+        for (int n = 0; n < nelements(TYPE##_entries); n++) { \
+                index->TYPE##_options.forced[n] = 0; \
+                if (!TYPE##_entries[n].base.once && !TYPE##_entries[n].base.readonly) { \
+                        index->TYPE##_options.forced[n] = getenv_##TYPE(index, TYPE##_entries[n].base.env_force, NOTIFY_ENV_FORCE, \
+                                                                        n, &index->TYPE##_options.forced_values[n], "Option"); \
+                } \
+        }
+
+        index->env_resolved = 0;
+        FOR_ALL_TYPES(RESOLVE_ENV_FORCE)
+        index->env_resolved = 1;
+}
+
 static int is_tunable_but_overriden(elpa_index_t index, int i, int autotune_level_old, int autotune_domain) {
         return (int_entries[i].autotune_level_old != 0) &&
                (int_entries[i].autotune_level_old <= autotune_level_old) &&
@@ -1649,6 +1911,23 @@ void elpa_index_print_int_parameter(elpa_index_t index, char* buff, int i)
         }
 }
 
+/* Kernels which can be set explicitly, but which are not tried by the
+ * autotuning, since they are not faster than the other blockings of their
+ * instruction set */
+static int is_autotuned_value(int i, int value) {
+        if (int_entries[i].valid == real_kernel_is_valid) {
+                switch(value) {
+                        case ELPA_2STAGE_REAL_AVX2_BLOCK8:
+                        case ELPA_2STAGE_REAL_AVX512_BLOCK8:
+                        case ELPA_2STAGE_REAL_SVE128_BLOCK8:
+                        case ELPA_2STAGE_REAL_SVE256_BLOCK8:
+                        case ELPA_2STAGE_REAL_SVE512_BLOCK8:
+                                return 0;
+                }
+        }
+        return 1;
+}
+
 int elpa_index_set_autotune_parameters(elpa_index_t index, int autotune_level_old, int autotune_domain, int current) {
         int current_cpy = current;
         char buff[100];
@@ -1660,7 +1939,7 @@ int elpa_index_set_autotune_parameters(elpa_index_t index, int autotune_level_ol
                int value = int_entries[i].enumerate(index, current_cpy % int_entries[i].cardinality(index));
                //if(elpa_index_is_printing_mpi_rank(index)) fprintf(stderr, "  * val[%d] = %d -> %d\n", i, current_cpy % int_entries[i].cardinality(index), value);
                /* Try to set option i to that value */
-               if (int_entries[i].valid(index, i, value)) {
+               if (int_entries[i].valid(index, i, value) && is_autotuned_value(i, value)) {
                   index->int_options.values[i] = value;
                } else {
                  //if(elpa_index_is_printing_mpi_rank(index)) fprintf(stderr, "  *NOT VALID becaluse of i %d (%s) and value %d translated to %d\n", i, int_entries[i].base.name, current_cpy % int_entries[i].cardinality(index), value);
@@ -1692,7 +1971,7 @@ int elpa_index_set_autotune_parameters_new_stepping(elpa_index_t index, int auto
 	       //printf("Trying to set value %d \n",value);
                //if(elpa_index_is_printing_mpi_rank(index)) fprintf(stderr, "  * val[%d] = %d -> %d\n", i, current_cpy % int_entries[i].cardinality(index), value);
                /* Try to set option i to that value */
-               if (int_entries[i].valid(index, i, value)) {
+               if (int_entries[i].valid(index, i, value) && is_autotuned_value(i, value)) {
                   index->int_options.values[i] = value;
                } else {
                  //if(elpa_index_is_printing_mpi_rank(index)) fprintf(stderr, "  *NOT VALID becaluse of i %d (%s) and value %d translated to %d\n", i, int_entries[i].base.name, current_cpy % int_entries[i].cardinality(index), value);
@@ -140,8 +140,11 @@ struct elpa_index_struct {
         TYPE *values; \
         int *is_set; \
         int *notified; \
+        int *forced; \
+        TYPE *forced_values; \
         } TYPE##_options;
         FOR_ALL_TYPES(STRUCT_MEMBERS)
+        int env_resolved;  /* the ELPA_FORCE_* variables have been read into forced/forced_values */
 };
 
 
@@ -167,6 +170,19 @@ elpa_index_t elpa_index_instance();
 void elpa_index_free(elpa_index_t index);
 
 
+/*
+ !f> interface
+ !f>   subroutine elpa_index_resolve_environment_c(index) bind(C, name="elpa_index_resolve_environment")
+ !f>     import c_ptr
+ !f>     type(c_ptr), value :: index
+ !f>   end subroutine
+ !f> end interface
+ */
+/*! \brief reads the ELPA_FORCE_* environment variables once; afterwards the
+ *  getters use the stored values instead of calling getenv() */
+void elpa_index_resolve_environment(elpa_index_t index);
+
+
 /*
  !f> interface
  !f>   function elpa_index_get_int_value_c(index, name, success) result(value) &
@@ -463,6 +479,26 @@ int elpa_option_enumerate(char *name, int i);
 int elpa_index_int_is_valid(elpa_index_t index, char *name, int new_value);
 
 
+/*
+ !f> interface
+ !f>   function elpa_2stage_kernel_is_compiled_c(is_real, kernel) result(compiled) &
+ !f>       bind(C, name="elpa_2stage_kernel_is_compiled")
+ !f>     import c_int
+ !f>     integer(kind=c_int), intent(in), value :: is_real, kernel
+ !f>     integer(kind=c_int) :: compiled
+ !f>   end function
+ !f> end interface
+ !f>
+ */
+/*! \brief whether an ELPA 2stage kernel has been compiled into the library
+ *
+ *  \param  is_real   1 for a real kernel, 0 for a complex kernel
+ *  \param  kernel    the kernel, e.g. ELPA_2STAGE_REAL_AVX2_BLOCK2
+ *  \return 1 if the kernel is available, 0 otherwise
+ */
+int elpa_2stage_kernel_is_compiled(int is_real, int kernel);
+
+
 /*
  !f> interface
  !f>   function elpa_index_autotune_cardinality_c(index, autotune_level, autotune_domain) result(n) &
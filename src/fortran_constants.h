@@ -53,6 +53,9 @@
 #define FORTRAN_CONSTANT(name, value, ...) \
         integer(kind=C_INT), parameter :: name = value !ELPA_C_DEFINE
 
+/* one term per line, the lists of kernels are too long for one Fortran line */
+#define FORTRAN_ENUM_SUM(name, value, ...) +1 & NEWLINE
+
 ! General constants
  ELPA_FOR_ALL_ERRORS(FORTRAN_CONSTANT)
 
@@ -68,13 +71,13 @@
 ! Real kernels
  ELPA_FOR_ALL_2STAGE_REAL_KERNELS_AND_DEFAULT(FORTRAN_CONSTANT)
 #undef ELPA_2STAGE_NUMBER_OF_REAL_KERNELS
- FORTRAN_CONSTANT(ELPA_2STAGE_NUMBER_OF_REAL_KERNELS, & NEWLINE (0 ELPA_FOR_ALL_2STAGE_REAL_KERNELS(ELPA_ENUM_SUM)))
+ FORTRAN_CONSTANT(ELPA_2STAGE_NUMBER_OF_REAL_KERNELS, & NEWLINE (0 & NEWLINE ELPA_FOR_ALL_2STAGE_REAL_KERNELS(FORTRAN_ENUM_SUM)))
 
 
 ! Complex kernels
  ELPA_FOR_ALL_2STAGE_COMPLEX_KERNELS_AND_DEFAULT(FORTRAN_CONSTANT)
 #undef ELPA_2STAGE_NUMBER_OF_COMPLEX_KERNELS
- FORTRAN_CONSTANT(ELPA_2STAGE_NUMBER_OF_COMPLEX_KERNELS, & NEWLINE (0 ELPA_FOR_ALL_2STAGE_COMPLEX_KERNELS(ELPA_ENUM_SUM)))
+ FORTRAN_CONSTANT(ELPA_2STAGE_NUMBER_OF_COMPLEX_KERNELS, & NEWLINE (0 & NEWLINE ELPA_FOR_ALL_2STAGE_COMPLEX_KERNELS(FORTRAN_ENUM_SUM)))
 
 
 ! Autotune
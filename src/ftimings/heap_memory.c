@@ -0,0 +1,88 @@
+/* Copyright 2026 ELPA consortium
+ *
+ * This file is part of ftimings.
+ *
+ * ftimings is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ftimings is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ftimings.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Bytes in use on the heap and their peak.
+ *
+ * The size is taken from the statistics of the allocator, so it counts every
+ * allocation of the process, also those of other libraries. The peak is
+ * sampled: by ftimings_heap_sample(), which the application calls after its
+ * allocations, and at the start and stop of every timer region. It is
+ * process-global, a timer region saves and restores it, such that the peaks
+ * of nested regions are kept apart.
+ *
+ * Memory which the application maps directly with mmap is not seen by the
+ * allocator; it is added with ftimings_heap_mapped().
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <stdatomic.h>
+#ifdef HAVE_MALLINFO2
+#include <malloc.h>
+#endif
+
+static atomic_int heap_tracking = 0;
+static atomic_long heap_peak = 0;
+static atomic_long heap_mapped = 0;
+
+long ftimings_heap_size(void) {
+#ifdef HAVE_MALLINFO2
+	struct mallinfo2 info = mallinfo2();
+	/* small blocks in the arenas, large blocks mapped with mmap by the allocator
+	 * and memory mapped by the application */
+	return (long) (info.uordblks + info.hblkhd) + atomic_load(&heap_mapped);
+#else
+	return 0L;
+#endif
+}
+
+/* bytes > 0: the application mapped bytes with mmap, bytes < 0: it unmapped them */
+void ftimings_heap_mapped(long bytes) {
+	atomic_fetch_add(&heap_mapped, bytes);
+}
+
+/* enabled != 0 registers one more timer that records the heap, enabled == 0 one less */
+void ftimings_heap_tracking(int enabled) {
+	if (enabled) {
+		atomic_fetch_add(&heap_tracking, 1);
+	} else {
+		atomic_fetch_sub(&heap_tracking, 1);
+	}
+}
+
+/* updates the peak with the current size; cheap if no timer records the heap */
+void ftimings_heap_sample(void) {
+	long size, peak;
+
+	if (atomic_load(&heap_tracking) <= 0) {
+		return;
+	}
+	size = ftimings_heap_size();
+	peak = atomic_load(&heap_peak);
+	while (size > peak && !atomic_compare_exchange_weak(&heap_peak, &peak, size)) {
+	}
+}
+
+long ftimings_heap_peak(void) {
+	return atomic_load(&heap_peak);
+}
+
+/* sets the peak to value and returns the previous peak */
+long ftimings_heap_peak_reset(long value) {
+	return atomic_exchange(&heap_peak, value);
+}
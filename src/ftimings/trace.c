@@ -0,0 +1,249 @@
+/* Copyright 2026 ELPA consortium
+ *
+ * This file is part of ftimings.
+ *
+ * ftimings is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ftimings is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ftimings.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Timeline of the timer regions in the Chrome/Perfetto trace event format.
+ *
+ * Every timer, which records a trace, gets its own id from ftimings_trace_new_id().
+ * Every thread, which starts a region of a trace, owns a ring buffer for this
+ * trace with the last FTIMINGS_TRACE_EVENTS completed regions, such that the
+ * traces of several timers are neither mixed nor cleared together. Only the
+ * owning thread writes to its buffer, the buffers are registered once in a
+ * lock-free list, and buffers of released traces are reused by their thread.
+ * The buffers of a trace should only be serialized while none of its regions
+ * is running.
+ */
+#define _POSIX_C_SOURCE 200112L
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef HAVE_CONFIG_H
+#include "config-f90.h"
+#endif
+
+#define FTIMINGS_TRACE_EVENTS    32768  /* must be a power of two */
+#define FTIMINGS_TRACE_DEPTH     64
+#define FTIMINGS_TRACE_NAME_LEN  48
+
+typedef struct {
+	int64_t begin;
+	int64_t duration;
+	char name[FTIMINGS_TRACE_NAME_LEN];
+} trace_event_t;
+
+typedef struct trace_buffer {
+	struct trace_buffer *next;      /* list of all buffers */
+	struct trace_buffer *next_own;  /* list of the buffers of the owning thread */
+	atomic_int trace;               /* id of the trace, 0 if released */
+	int tid;
+	int depth;
+	uint64_t n_events;
+	int64_t stack_begin[FTIMINGS_TRACE_DEPTH];
+	char stack_name[FTIMINGS_TRACE_DEPTH][FTIMINGS_TRACE_NAME_LEN];
+	trace_event_t events[FTIMINGS_TRACE_EVENTS];
+} trace_buffer_t;
+
+static _Atomic(trace_buffer_t *) trace_buffers = NULL;
+static atomic_int trace_n_threads = 0;
+static atomic_int trace_n_ids = 0;
+static _Thread_local trace_buffer_t *trace_my_buffers = NULL;
+static _Thread_local int trace_my_tid = -1;
+
+static int64_t trace_nanoseconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (int64_t) ts.tv_sec * (int64_t) 1000000000 + (int64_t) ts.tv_nsec;
+}
+
+/* The buffer of the calling thread for trace, NULL if create is 0 and there is none yet */
+static trace_buffer_t *trace_buffer(int trace, int create) {
+	trace_buffer_t *buffer;
+
+	for (buffer = trace_my_buffers; buffer != NULL; buffer = buffer->next_own) {
+		if (atomic_load(&buffer->trace) == trace) {
+			return buffer;
+		}
+	}
+	if (!create) {
+		return NULL;
+	}
+	if (trace_my_tid < 0) {
+		trace_my_tid = atomic_fetch_add(&trace_n_threads, 1);
+	}
+	/* reuse a buffer of a released trace */
+	for (buffer = trace_my_buffers; buffer != NULL; buffer = buffer->next_own) {
+		if (atomic_load(&buffer->trace) == 0) {
+			buffer->depth = 0;
+			buffer->n_events = 0;
+			atomic_store(&buffer->trace, trace);
+			return buffer;
+		}
+	}
+	buffer = calloc(1, sizeof(trace_buffer_t));
+	if (buffer == NULL) {
+		return NULL;
+	}
+	buffer->tid = trace_my_tid;
+	atomic_store(&buffer->trace, trace);
+	buffer->next_own = trace_my_buffers;
+	trace_my_buffers = buffer;
+	buffer->next = atomic_load(&trace_buffers);
+	while (!atomic_compare_exchange_weak(&trace_buffers, &buffer->next, buffer)) {
+	}
+	return buffer;
+}
+
+/* A new trace id, always > 0 */
+int ftimings_trace_new_id(void) {
+	return atomic_fetch_add(&trace_n_ids, 1) + 1;
+}
+
+void ftimings_trace_begin(int trace, const char *name, int name_len) {
+	trace_buffer_t *buffer = trace_buffer(trace, 1);
+	int i, n;
+
+	if (buffer == NULL) {
+		return;
+	}
+	if (buffer->depth < FTIMINGS_TRACE_DEPTH) {
+		n = name_len < FTIMINGS_TRACE_NAME_LEN - 1 ? name_len : FTIMINGS_TRACE_NAME_LEN - 1;
+		while (n > 0 && name[n-1] == ' ') {
+			n--;
+		}
+		/* the names end up in JSON strings */
+		for (i = 0; i < n; i++) {
+			buffer->stack_name[buffer->depth][i] =
+				(name[i] == '"' || name[i] == '\\' || (unsigned char) name[i] < 0x20) ? '_' : name[i];
+		}
+		buffer->stack_name[buffer->depth][n] = '\0';
+		buffer->stack_begin[buffer->depth] = trace_nanoseconds();
+	}
+	buffer->depth++;
+}
+
+void ftimings_trace_end(int trace) {
+	trace_buffer_t *buffer = trace_buffer(trace, 0);
+	trace_event_t *event;
+
+	if (buffer == NULL || buffer->depth == 0) {
+		return;
+	}
+	buffer->depth--;
+	if (buffer->depth < FTIMINGS_TRACE_DEPTH) {
+		event = &buffer->events[buffer->n_events & (FTIMINGS_TRACE_EVENTS - 1)];
+		event->begin = buffer->stack_begin[buffer->depth];
+		event->duration = trace_nanoseconds() - event->begin;
+		memcpy(event->name, buffer->stack_name[buffer->depth], FTIMINGS_TRACE_NAME_LEN);
+		buffer->n_events++;
+	}
+}
+
+static uint64_t trace_first_event(const trace_buffer_t *buffer) {
+	return buffer->n_events > FTIMINGS_TRACE_EVENTS ? buffer->n_events - FTIMINGS_TRACE_EVENTS : 0;
+}
+
+/* Earliest begin of all recorded regions of trace in ns, INT64_MAX if nothing was recorded */
+int64_t ftimings_trace_first_timestamp(int trace) {
+	int64_t first = INT64_MAX;
+	trace_buffer_t *buffer;
+	uint64_t i;
+
+	for (buffer = atomic_load(&trace_buffers); buffer != NULL; buffer = buffer->next) {
+		if (atomic_load(&buffer->trace) != trace) {
+			continue;
+		}
+		for (i = trace_first_event(buffer); i < buffer->n_events; i++) {
+			if (buffer->events[i & (FTIMINGS_TRACE_EVENTS - 1)].begin < first) {
+				first = buffer->events[i & (FTIMINGS_TRACE_EVENTS - 1)].begin;
+			}
+		}
+	}
+	return first;
+}
+
+/* Serializes the recorded regions of trace as comma separated trace events of process
+ * pid, with timestamps relative to origin (in ns). The string has to be released with
+ * ftimings_trace_free(). Returns the length of the string or -1 on failure */
+int64_t ftimings_trace_serialize(int trace, int pid, int64_t origin, char **json) {
+	trace_buffer_t *buffer;
+	size_t size = 256, len = 0;
+	uint64_t i;
+	char *text;
+	int n;
+
+	for (buffer = atomic_load(&trace_buffers); buffer != NULL; buffer = buffer->next) {
+		if (atomic_load(&buffer->trace) == trace) {
+			size += 128 + (buffer->n_events - trace_first_event(buffer)) * (FTIMINGS_TRACE_NAME_LEN + 128);
+		}
+	}
+	text = malloc(size);
+	if (text == NULL) {
+		*json = NULL;
+		return -1;
+	}
+
+	len += snprintf(text + len, size - len,
+	                "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}}", pid, pid);
+	for (buffer = atomic_load(&trace_buffers); buffer != NULL; buffer = buffer->next) {
+		if (atomic_load(&buffer->trace) != trace) {
+			continue;
+		}
+		len += snprintf(text + len, size - len,
+		                ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+		                pid, buffer->tid, buffer->tid);
+		for (i = trace_first_event(buffer); i < buffer->n_events; i++) {
+			const trace_event_t *event = &buffer->events[i & (FTIMINGS_TRACE_EVENTS - 1)];
+			n = snprintf(text + len, size - len,
+			             ",\n{\"name\":\"%s\",\"cat\":\"elpa\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+			             event->name, (event->begin - origin) / 1e3, event->duration / 1e3, pid, buffer->tid);
+			len += n;
+		}
+	}
+
+	*json = text;
+	return (int64_t) len;
+}
+
+void ftimings_trace_free(char *json) {
+	free(json);
+}
+
+/* Discards all recorded regions of trace; regions, which are still running, are kept */
+void ftimings_trace_clear(int trace) {
+	trace_buffer_t *buffer;
+
+	for (buffer = atomic_load(&trace_buffers); buffer != NULL; buffer = buffer->next) {
+		if (atomic_load(&buffer->trace) == trace) {
+			buffer->n_events = 0;
+		}
+	}
+}
+
+/* Discards trace, its buffers are reused by later traces of the same threads */
+void ftimings_trace_release(int trace) {
+	trace_buffer_t *buffer;
+
+	for (buffer = atomic_load(&trace_buffers); buffer != NULL; buffer = buffer->next) {
+		if (atomic_load(&buffer->trace) == trace) {
+			atomic_store(&buffer->trace, 0);
+		}
+	}
+}
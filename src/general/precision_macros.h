@@ -86,6 +86,7 @@
 #undef  PRECISION_GEQRF
 #undef  PRECISION_STEDC
 #undef  PRECISION_STEQR
+#undef  PRECISION_STERF
 #undef  PRECISION_LAMRG
 #undef  PRECISION_LAMCH
 #undef  PRECISION_LAPY2
@@ -195,6 +196,7 @@
 #define  PRECISION_GEQRF DGEQRF
 #define  PRECISION_STEDC DSTEDC
 #define  PRECISION_STEQR DSTEQR
+#define  PRECISION_STERF DSTERF
 #define  PRECISION_LAMRG DLAMRG
 #define  PRECISION_LAMCH DLAMCH
 #define  PRECISION_LAPY2 DLAPY2
@@ -302,6 +304,7 @@
 #define  PRECISION_GEQRF SGEQRF
 #define  PRECISION_STEDC SSTEDC
 #define  PRECISION_STEQR SSTEQR
+#define  PRECISION_STERF SSTERF
 #define  PRECISION_LAMRG SLAMRG
 #define  PRECISION_LAMCH SLAMCH
 #define  PRECISION_LAPY2 SLAPY2
@@ -422,6 +425,7 @@
 #undef  PRECISION_GEQRF
 #undef  PRECISION_STEDC
 #undef  PRECISION_STEQR
+#undef  PRECISION_STERF
 #undef  PRECISION_LAMRG
 #undef  PRECISION_LAMCH
 #undef  PRECISION_LAPY2
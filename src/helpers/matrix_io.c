@@ -0,0 +1,413 @@
+//    This file is part of ELPA.
+//
+//    The ELPA library was originally created by the ELPA consortium,
+//    consisting of the following organizations:
+//
+//    - Max Planck Computing and Data Facility (MPCDF), formerly known as
+//      Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+//    - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+//      Informatik,
+//    - Technische Universität München, Lehrstuhl für Informatik mit
+//      Schwerpunkt Wissenschaftliches Rechnen ,
+//    - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+//    - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+//      Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+//      and
+//    - IBM Deutschland GmbH
+//
+//    More information can be found here:
+//    http://elpa.mpcdf.mpg.de/
+//
+//    ELPA is free software: you can redistribute it and/or modify
+//    it under the terms of the version 3 of the license of the
+//    GNU Lesser General Public License as published by the Free
+//    Software Foundation.
+//
+//    ELPA is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with ELPA. If not, see <http://www.gnu.org/licenses/>
+//
+//    ELPA reflects a substantial effort on the part of the original
+//    ELPA consortium, and we ask you to respect the spirit of the
+//    license that we chose: i.e., please contribute any changes you
+//    may have back to the original ELPA library distribution, and keep
+//    any derivatives of ELPA under the same license that we chose for
+//    the original distribution, the GNU Lesser General Public License.
+//
+
+// Reading and writing of block-cyclic distributed matrices.
+//
+// File format (all values in the native byte order of the writer):
+//
+//   offset  0  char[8]   "ELPAMAT" followed by a zero byte
+//   offset  8  int32     format version (1)
+//   offset 12  int32     data type: 1 real double, 2 real single,
+//                                   3 complex double, 4 complex single
+//   offset 16  int64     number of rows
+//   offset 24  int64     number of columns
+//   offset 32  uint32    byte order mark 0x01020304
+//   offset 36            reserved, zero
+//   offset 64            the global matrix in column-major order
+//
+// With MPI every process reads or writes its local blocks with one collective
+// MPI-IO call through a distributed-array file view. If all processes run on
+// one node, matrices are read with mmap from the shared page cache instead.
+
+#define _XOPEN_SOURCE 700
+#include "config-f90.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+#include <elpa/elpa.h>
+
+#define MATRIX_IO_MAGIC "ELPAMAT"
+#define MATRIX_IO_VERSION 1
+#define MATRIX_IO_BYTE_ORDER 0x01020304u
+#define MATRIX_IO_HEADER_SIZE 64
+
+typedef struct {
+	char magic[8];
+	int32_t version;
+	int32_t datatype;
+	int64_t nrows;
+	int64_t ncols;
+	uint32_t byte_order;
+	char reserved[MATRIX_IO_HEADER_SIZE - 36];
+} matrix_io_header_t;
+
+static size_t element_size(int datatype) {
+	switch (datatype) {
+		case 1: return sizeof(double);
+		case 2: return sizeof(float);
+		case 3: return 2 * sizeof(double);
+		case 4: return 2 * sizeof(float);
+		default: return 0;
+	}
+}
+
+/* number of rows or columns of the distributed matrix on a process (ScaLAPACK numroc) */
+static int64_t local_size(int64_t n, int64_t nblk, int64_t iproc, int64_t nprocs) {
+	int64_t nblocks = n / nblk;
+	int64_t result = (nblocks / nprocs) * nblk;
+	int64_t extra = nblocks % nprocs;
+
+	if (iproc < extra) {
+		result += nblk;
+	} else if (iproc == extra) {
+		result += n % nblk;
+	}
+	return result;
+}
+
+static int check_header(const matrix_io_header_t *header, int datatype, int64_t na, const char *file_name) {
+	if (memcmp(header->magic, MATRIX_IO_MAGIC, 8) != 0 || header->version != MATRIX_IO_VERSION) {
+		fprintf(stderr, "ELPA: %s is not an ELPA matrix file\n", file_name);
+		return ELPA_ERROR;
+	}
+	if (header->byte_order != MATRIX_IO_BYTE_ORDER) {
+		fprintf(stderr, "ELPA: %s has been written with a different byte order\n", file_name);
+		return ELPA_ERROR;
+	}
+	if (header->datatype != datatype) {
+		fprintf(stderr, "ELPA: the data type of %s does not match the matrix\n", file_name);
+		return ELPA_ERROR;
+	}
+	if (header->nrows != na || header->ncols != na) {
+		fprintf(stderr, "ELPA: %s contains a %lld x %lld matrix, expected na = %lld\n", file_name,
+		        (long long) header->nrows, (long long) header->ncols, (long long) na);
+		return ELPA_ERROR;
+	}
+	return ELPA_OK;
+}
+
+static void make_header(matrix_io_header_t *header, int datatype, int64_t na) {
+	memset(header, 0, sizeof(*header));
+	memcpy(header->magic, MATRIX_IO_MAGIC, 8);
+	header->version = MATRIX_IO_VERSION;
+	header->datatype = datatype;
+	header->nrows = na;
+	header->ncols = na;
+	header->byte_order = MATRIX_IO_BYTE_ORDER;
+}
+
+/* Copies the local blocks from the global column-major matrix in the file to a */
+static void copy_local_blocks(const char *file_data, char *a, size_t es, int64_t na, int64_t nblk,
+                              int64_t lda, int64_t process_row, int64_t process_col, int64_t np_rows, int64_t np_cols) {
+	int64_t nrows = local_size(na, nblk, process_row, np_rows);
+	int64_t ncols = local_size(na, nblk, process_col, np_cols);
+	int64_t j, i, gj, gi, len;
+
+	for (j = 0; j < ncols; j++) {
+		gj = (j / nblk) * nblk * np_cols + process_col * nblk + j % nblk;
+		for (i = 0; i < nrows; i += nblk) {
+			gi = (i / nblk) * nblk * np_rows + process_row * nblk;
+			len = nrows - i < nblk ? nrows - i : nblk;
+			memcpy(a + (j * lda + i) * es, file_data + (gj * na + gi) * es, len * es);
+		}
+	}
+}
+
+static int read_header_posix(int fd, matrix_io_header_t *header) {
+	return pread(fd, header, sizeof(*header), 0) == (ssize_t) sizeof(*header) ? ELPA_OK : ELPA_ERROR;
+}
+
+/* Reads the local blocks from a memory map of the file */
+static int read_mmap(const char *file_name, char *a, int datatype, int64_t na, int64_t nblk, int64_t lda,
+                     int64_t process_row, int64_t process_col, int64_t np_rows, int64_t np_cols) {
+	size_t es = element_size(datatype);
+	size_t size = MATRIX_IO_HEADER_SIZE + (size_t) na * (size_t) na * es;
+	matrix_io_header_t header;
+	struct stat st;
+	void *map;
+	int fd, error;
+
+	fd = open(file_name, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "ELPA: cannot open %s: %s\n", file_name, strerror(errno));
+		return ELPA_ERROR;
+	}
+	error = read_header_posix(fd, &header);
+	if (error == ELPA_OK) {
+		error = check_header(&header, datatype, na, file_name);
+	}
+	if (error == ELPA_OK && (fstat(fd, &st) != 0 || (size_t) st.st_size < size)) {
+		fprintf(stderr, "ELPA: %s is truncated\n", file_name);
+		error = ELPA_ERROR;
+	}
+	if (error != ELPA_OK) {
+		close(fd);
+		return error;
+	}
+
+	map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		fprintf(stderr, "ELPA: cannot map %s: %s\n", file_name, strerror(errno));
+		return ELPA_ERROR;
+	}
+#ifdef MADV_SEQUENTIAL
+	if (np_rows == 1) {
+		madvise(map, size, MADV_SEQUENTIAL);
+	}
+#endif
+	copy_local_blocks((const char *) map + MATRIX_IO_HEADER_SIZE, a, es, na, nblk, lda,
+	                  process_row, process_col, np_rows, np_cols);
+	munmap(map, size);
+	return ELPA_OK;
+}
+
+#ifndef WITH_MPI
+/* Writes the (complete) local matrix of a run without MPI */
+static int write_posix(const char *file_name, char *a, int datatype, int64_t na, int64_t lda) {
+	size_t es = element_size(datatype);
+	matrix_io_header_t header;
+	int64_t j;
+	int fd, error = ELPA_OK;
+
+	fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		fprintf(stderr, "ELPA: cannot create %s: %s\n", file_name, strerror(errno));
+		return ELPA_ERROR;
+	}
+	make_header(&header, datatype, na);
+	if (write(fd, &header, sizeof(header)) != (ssize_t) sizeof(header)) {
+		error = ELPA_ERROR;
+	}
+	for (j = 0; j < na && error == ELPA_OK; j++) {
+		if (pwrite(fd, a + j * lda * es, na * es, MATRIX_IO_HEADER_SIZE + j * na * es) != (ssize_t) (na * es)) {
+			error = ELPA_ERROR;
+		}
+	}
+	if (close(fd) != 0 || error != ELPA_OK) {
+		fprintf(stderr, "ELPA: writing %s failed\n", file_name);
+		error = ELPA_ERROR;
+	}
+	return error;
+}
+
+#else /* WITH_MPI */
+
+/* Creates the file view of the local blocks and the memory layout of the local matrix */
+static void create_types(int datatype, int64_t na, int64_t nblk, int64_t lda, int process_row, int process_col,
+                         int np_rows, int np_cols, MPI_Datatype *etype, MPI_Datatype *filetype, MPI_Datatype *memtype) {
+	int gsizes[2] = {(int) na, (int) na};
+	int distribs[2] = {MPI_DISTRIBUTE_CYCLIC, MPI_DISTRIBUTE_CYCLIC};
+	int dargs[2] = {(int) nblk, (int) nblk};
+	int psizes[2] = {np_rows, np_cols};
+	int64_t nrows = local_size(na, nblk, process_row, np_rows);
+	int64_t ncols = local_size(na, nblk, process_col, np_cols);
+
+	if (datatype == 1 || datatype == 3) {
+		MPI_Type_contiguous(datatype == 1 ? 1 : 2, MPI_DOUBLE, etype);
+	} else {
+		MPI_Type_contiguous(datatype == 2 ? 1 : 2, MPI_FLOAT, etype);
+	}
+	MPI_Type_commit(etype);
+
+	/* the darray process grid is row-major, independent of the ranks in the communicator */
+	MPI_Type_create_darray(np_rows * np_cols, process_row * np_cols + process_col, 2, gsizes, distribs, dargs,
+	                       psizes, MPI_ORDER_FORTRAN, *etype, filetype);
+	MPI_Type_commit(filetype);
+
+	MPI_Type_vector((int) ncols, (int) nrows, (int) lda, *etype, memtype);
+	MPI_Type_commit(memtype);
+}
+
+static void free_types(MPI_Datatype *etype, MPI_Datatype *filetype, MPI_Datatype *memtype) {
+	MPI_Type_free(memtype);
+	MPI_Type_free(filetype);
+	MPI_Type_free(etype);
+}
+
+/* Are all processes of comm on the same node? */
+static int single_node(MPI_Comm comm) {
+	MPI_Comm node_comm;
+	int size, node_size;
+
+	MPI_Comm_size(comm, &size);
+	MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+	MPI_Comm_size(node_comm, &node_size);
+	MPI_Comm_free(&node_comm);
+	return node_size == size;
+}
+
+static int read_mpi_io(MPI_Comm comm, const char *file_name, char *a, int datatype, int64_t na, int64_t nblk,
+                       int64_t lda, int process_row, int process_col, int np_rows, int np_cols) {
+	MPI_Datatype etype, filetype, memtype;
+	MPI_File fh;
+	int error;
+
+	if (MPI_File_open(comm, file_name, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+		fprintf(stderr, "ELPA: cannot open %s with MPI-IO\n", file_name);
+		return ELPA_ERROR;
+	}
+	create_types(datatype, na, nblk, lda, process_row, process_col, np_rows, np_cols, &etype, &filetype, &memtype);
+	MPI_File_set_view(fh, MATRIX_IO_HEADER_SIZE, etype, filetype, "native", MPI_INFO_NULL);
+	error = MPI_File_read_all(fh, a, 1, memtype, MPI_STATUS_IGNORE) == MPI_SUCCESS ? ELPA_OK : ELPA_ERROR;
+	MPI_File_close(&fh);
+	free_types(&etype, &filetype, &memtype);
+	return error;
+}
+
+static int write_mpi_io(MPI_Comm comm, const char *file_name, char *a, int datatype, int64_t na, int64_t nblk,
+                        int64_t lda, int process_row, int process_col, int np_rows, int np_cols) {
+	MPI_Datatype etype, filetype, memtype;
+	matrix_io_header_t header;
+	MPI_File fh;
+	int rank, error = ELPA_OK;
+
+	if (MPI_File_open(comm, file_name, MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+		fprintf(stderr, "ELPA: cannot create %s with MPI-IO\n", file_name);
+		return ELPA_ERROR;
+	}
+	MPI_File_set_size(fh, MATRIX_IO_HEADER_SIZE + (MPI_Offset) na * na * (MPI_Offset) element_size(datatype));
+	MPI_Comm_rank(comm, &rank);
+	if (rank == 0) {
+		make_header(&header, datatype, na);
+		if (MPI_File_write_at(fh, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE) != MPI_SUCCESS) {
+			error = ELPA_ERROR;
+		}
+	}
+	create_types(datatype, na, nblk, lda, process_row, process_col, np_rows, np_cols, &etype, &filetype, &memtype);
+	MPI_File_set_view(fh, MATRIX_IO_HEADER_SIZE, etype, filetype, "native", MPI_INFO_NULL);
+	if (MPI_File_write_all(fh, a, 1, memtype, MPI_STATUS_IGNORE) != MPI_SUCCESS) {
+		error = ELPA_ERROR;
+	}
+	MPI_File_close(&fh);
+	free_types(&etype, &filetype, &memtype);
+	return error;
+}
+#endif /* WITH_MPI */
+
+/*
+!f> interface
+!f>   function elpa_matrix_io_c(do_write, file_name, a, datatype, na, nblk, lda, process_row, process_col, &
+!f>                             np_rows, np_cols, mpi_comm_parent) result(error) bind(C, name="elpa_matrix_io")
+!f>     use, intrinsic :: iso_c_binding
+!f>     implicit none
+!f>     integer(kind=c_int), value         :: do_write, datatype, na, nblk, lda, process_row, process_col, &
+!f>                                           np_rows, np_cols, mpi_comm_parent
+!f>     character(kind=c_char), intent(in) :: file_name(*)
+!f>     type(c_ptr), value                 :: a
+!f>     integer(kind=c_int)                :: error
+!f>   end function
+!f> end interface
+*/
+/* Reads (do_write = 0) or writes the local blocks a(lda, *) of the block-cyclic distributed
+ * na x na matrix on process (process_row, process_col) of an np_rows x np_cols grid */
+int elpa_matrix_io(int do_write, const char *file_name, void *a, int datatype, int na, int nblk, int lda,
+                   int process_row, int process_col, int np_rows, int np_cols, int mpi_comm_parent) {
+	int error = ELPA_OK;
+
+	if (element_size(datatype) == 0 || na < 1 || nblk < 1 ||
+	    lda < local_size(na, nblk, process_row, np_rows)) {
+		error = ELPA_ERROR;
+	}
+
+#ifdef WITH_MPI
+	MPI_Comm comm = MPI_Comm_f2c(mpi_comm_parent);
+	matrix_io_header_t header;
+	int rank, all_error;
+
+	/* the arguments may be wrong on a single process only: agree on them before
+	 * the collective file operations, so that no process is left waiting in them */
+	MPI_Allreduce(&error, &all_error, 1, MPI_INT, MPI_MIN, comm);
+	if (all_error != ELPA_OK) {
+		error = all_error;
+	} else if (do_write) {
+		error = write_mpi_io(comm, file_name, a, datatype, na, nblk, lda, process_row, process_col, np_rows, np_cols);
+	} else {
+		/* the header is read once and broadcast */
+		MPI_Comm_rank(comm, &rank);
+		if (rank == 0) {
+			int fd = open(file_name, O_RDONLY);
+			if (fd < 0) {
+				fprintf(stderr, "ELPA: cannot open %s: %s\n", file_name, strerror(errno));
+				error = ELPA_ERROR;
+			} else {
+				error = read_header_posix(fd, &header);
+				close(fd);
+				if (error == ELPA_OK) {
+					error = check_header(&header, datatype, na, file_name);
+				}
+			}
+		}
+		MPI_Bcast(&error, 1, MPI_INT, 0, comm);
+		if (error == ELPA_OK) {
+			if (single_node(comm)) {
+				error = read_mmap(file_name, a, datatype, na, nblk, lda, process_row, process_col, np_rows, np_cols);
+			} else {
+				error = read_mpi_io(comm, file_name, a, datatype, na, nblk, lda, process_row, process_col, np_rows, np_cols);
+			}
+		}
+	}
+	MPI_Allreduce(&error, &all_error, 1, MPI_INT, MPI_MIN, comm);
+	return all_error;
+#else
+	(void) mpi_comm_parent;
+	if (error != ELPA_OK) {
+		return error;
+	}
+	if (do_write) {
+		error = write_posix(file_name, a, datatype, na, lda);
+	} else {
+		error = read_mmap(file_name, a, datatype, na, nblk, lda, 0, 0, 1, 1);
+	}
+	return error;
+#endif
+}
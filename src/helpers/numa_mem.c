@@ -0,0 +1,123 @@
+//    This file is part of ELPA.
+//
+//    The ELPA library was originally created by the ELPA consortium,
+//    consisting of the following organizations:
+//
+//    - Max Planck Computing and Data Facility (MPCDF), formerly known as
+//      Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+//    - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+//      Informatik,
+//    - Technische Universität München, Lehrstuhl für Informatik mit
+//      Schwerpunkt Wissenschaftliches Rechnen ,
+//    - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+//    - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+//      Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+//      and
+//    - IBM Deutschland GmbH
+//
+//    More information can be found here:
+//    http://elpa.mpcdf.mpg.de/
+//
+//    ELPA is free software: you can redistribute it and/or modify
+//    it under the terms of the version 3 of the license of the
+//    GNU Lesser General Public License as published by the Free
+//    Software Foundation.
+//
+//    ELPA is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with ELPA. If not, see <http://www.gnu.org/licenses/>
+//
+//    ELPA reflects a substantial effort on the part of the original
+//    ELPA consortium, and we ask you to respect the spirit of the
+//    license that we chose: i.e., please contribute any changes you
+//    may have back to the original ELPA library distribution, and keep
+//    any derivatives of ELPA under the same license that we chose for
+//    the original distribution, the GNU Lesser General Public License.
+//
+
+// Work space of the multithreaded parts of ELPA.
+//
+// The work arrays of trans_ev_tridi_to_band are split into one slice per
+// OpenMP thread. The pages of a slice should be on the NUMA node of the thread
+// that works on it. With the first-touch policy of the operating system this
+// requires pages which have not been touched before. malloc hands out recycled
+// memory for repeated calls, so the memory is taken directly from mmap.
+// The heap measurement of the timings does not see these pages, so they are
+// reported to it.
+
+#define _DEFAULT_SOURCE
+#include "config.h"
+
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#if defined(HAVE_DETAILED_TIMINGS) && defined(MAP_ANONYMOUS)
+/* see src/ftimings/heap_memory.c */
+void ftimings_heap_mapped(long bytes);
+void ftimings_heap_sample(void);
+#endif
+
+/* alignment if mmap is not available */
+#define NUMA_MEM_ALIGNMENT 64
+
+/*
+ !f> interface
+ !f>   function elpa_numa_alloc_c(size) result(ptr) bind(C, name="elpa_numa_alloc")
+ !f>     import c_ptr, c_intptr_t
+ !f>     integer(kind=c_intptr_t), value :: size
+ !f>     type(c_ptr) :: ptr
+ !f>   end function
+ !f> end interface
+ */
+void *elpa_numa_alloc(size_t size) {
+	void *ptr;
+
+	if (size == 0) {
+		size = 1;
+	}
+#ifdef MAP_ANONYMOUS
+	ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ptr == MAP_FAILED) {
+		return NULL;
+	}
+#ifdef HAVE_DETAILED_TIMINGS
+	ftimings_heap_mapped((long) size);
+	ftimings_heap_sample();
+#endif
+#else
+	if (posix_memalign(&ptr, NUMA_MEM_ALIGNMENT, size) != 0) {
+		return NULL;
+	}
+#endif
+	return ptr;
+}
+
+/*
+ !f> interface
+ !f>   subroutine elpa_numa_free_c(ptr, size) bind(C, name="elpa_numa_free")
+ !f>     import c_ptr, c_intptr_t
+ !f>     type(c_ptr), value :: ptr
+ !f>     integer(kind=c_intptr_t), value :: size
+ !f>   end subroutine
+ !f> end interface
+ */
+void elpa_numa_free(void *ptr, size_t size) {
+	if (ptr == NULL) {
+		return;
+	}
+	if (size == 0) {
+		size = 1;
+	}
+#ifdef MAP_ANONYMOUS
+	munmap(ptr, size);
+#ifdef HAVE_DETAILED_TIMINGS
+	ftimings_heap_mapped(-(long) size);
+#endif
+#else
+	free(ptr);
+#endif
+}
@@ -0,0 +1,175 @@
+/*   This file is part of ELPA.
+
+     The ELPA library was originally created by the ELPA consortium,
+     consisting of the following organizations:
+
+     - Max Planck Computing and Data Facility (MPCDF), formerly known as
+       Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+     - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+       Informatik,
+     - Technische Universität München, Lehrstuhl für Informatik mit
+       Schwerpunkt Wissenschaftliches Rechnen ,
+     - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+     - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+       Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+       and
+     - IBM Deutschland GmbH
+
+
+     More information can be found here:
+     http://elpa.mpcdf.mpg.de/
+
+     ELPA is free software: you can redistribute it and/or modify
+     it under the terms of the version 3 of the license of the
+     GNU Lesser General Public License as published by the Free
+     Software Foundation.
+
+     ELPA is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU Lesser General Public License for more details.
+
+     You should have received a copy of the GNU Lesser General Public License
+     along with ELPA.  If not, see <http://www.gnu.org/licenses/>
+
+     ELPA reflects a substantial effort on the part of the original
+     ELPA consortium, and we ask you to respect the spirit of the
+     license that we chose: i.e., please contribute any changes you
+     may have back to the original ELPA library distribution, and keep
+     any derivatives of ELPA under the same license that we chose for
+     the original distribution, the GNU Lesser General Public License.
+*/
+
+/* Test of the header-only C++ interface elpa/elpa.hpp: the solve with
+ * elpa::solver on views of the user matrices, typed options, and the
+ * translation of ELPA error codes into elpa::error */
+
+#include "config.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+#include <elpa/elpa.hpp>
+
+#ifdef HAVE_64BIT_INTEGER_MATH_SUPPORT
+#define TEST_C_INT_TYPE_PTR long int*
+#define TEST_C_INT_TYPE long int
+#else
+#define TEST_C_INT_TYPE_PTR int*
+#define TEST_C_INT_TYPE int
+#endif
+
+#ifdef HAVE_64BIT_INTEGER_MPI_SUPPORT
+#define TEST_C_INT_MPI_TYPE_PTR long int*
+#define TEST_C_INT_MPI_TYPE long int
+#else
+#define TEST_C_INT_MPI_TYPE_PTR int*
+#define TEST_C_INT_MPI_TYPE int
+#endif
+
+#include "test/shared/generated.h"
+
+int main(int argc, char** argv) {
+   TEST_C_INT_TYPE na = 150, nev = 75, nblk = 16;
+   TEST_C_INT_TYPE myid = 0, nprocs = 1, np_rows, np_cols, my_prow, my_pcol, na_rows, na_cols;
+   TEST_C_INT_TYPE mpi_comm = 0, my_blacs_ctxt, sc_desc[9], info, blacs_ok, status = 0;
+
+#ifdef WITH_MPI
+   TEST_C_INT_MPI_TYPE myidMPI, nprocsMPI;
+   MPI_Init(&argc, &argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocsMPI);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myidMPI);
+   nprocs = (TEST_C_INT_TYPE) nprocsMPI;
+   myid = (TEST_C_INT_TYPE) myidMPI;
+   mpi_comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+#endif
+
+#if defined(HAVE_64BIT_INTEGER_MPI_SUPPORT) || defined(HAVE_64BIT_INTEGER_MATH_SUPPORT) || defined(HAVE_64BIT_INTEGER_SUPPORT)
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+   return 77;
+#endif
+
+   for (np_cols = (TEST_C_INT_TYPE) std::sqrt((double) nprocs); np_cols > 1; np_cols--) {
+     if (nprocs % np_cols == 0) {
+       break;
+     }
+   }
+   np_rows = nprocs/np_cols;
+
+   set_up_blacsgrid_f(mpi_comm, np_rows, np_cols, 'C', &my_blacs_ctxt, &my_prow, &my_pcol);
+   set_up_blacs_descriptor_f(na, nblk, my_prow, my_pcol, np_rows, np_cols, &na_rows, &na_cols, sc_desc, my_blacs_ctxt, &info, &blacs_ok);
+   if (blacs_ok == 0) {
+     std::fprintf(stderr, "Setting up the blacsgrid failed. Aborting...\n");
+     std::abort();
+   }
+
+   std::vector<double> a(na_rows*na_cols), z(na_rows*na_cols), as(na_rows*na_cols), ev(na);
+   prepare_matrix_random_real_double_f(na, myid, na_rows, na_cols, sc_desc, a.data(), z.data(), as.data(), 0);
+
+   try {
+     elpa::library lib;
+
+     for (int solver : {ELPA_SOLVER_1STAGE, ELPA_SOLVER_2STAGE}) {
+       elpa::solver s;
+       s.set(elpa::opt::na, na)
+        .set(elpa::opt::nev, nev)
+        .set(elpa::opt::local_nrows, na_rows)
+        .set(elpa::opt::local_ncols, na_cols)
+        .set(elpa::opt::nblk, nblk);
+#ifdef WITH_MPI
+       s.set_communicator(MPI_COMM_WORLD, my_prow, my_pcol);
+#endif
+       s.setup();
+       s.set(elpa::opt::solver, solver).set(elpa::opt::timings, false);
+
+       if (s.get(elpa::opt::solver) != solver || s.get(elpa::opt::timings)) {
+         std::fprintf(stderr, "Error: options were not set\n");
+         status = 1;
+       }
+
+       /* the solver overwrites a */
+       a = as;
+       s.eigenvectors(elpa::matrix_view<double>(a.data(), na_rows, na_cols), ev.data(),
+                      elpa::matrix_view<double>(z.data(), na_rows, na_cols));
+
+       status += check_correctness_evp_numeric_residuals_real_double_f(na, nev, na_rows, na_cols, as.data(), z.data(), ev.data(),
+                                                                       sc_desc, nblk, myid, np_rows, np_cols, my_prow, my_pcol);
+
+       /* views, which do not match the local matrix, are rejected before calling ELPA */
+       try {
+         s.eigenvalues(elpa::matrix_view<double>(a.data(), na_rows, na_cols + 1), ev.data());
+         std::fprintf(stderr, "Error: a mismatching matrix view has been accepted\n");
+         status = 1;
+       } catch (const std::invalid_argument &) {
+       }
+
+       /* errors of ELPA are thrown as elpa::error */
+       try {
+         s.set(elpa::opt::nev, na + 1);
+         std::fprintf(stderr, "Error: nev > na has been accepted\n");
+         status = 1;
+       } catch (const elpa::error &e) {
+         if (e.code() == ELPA_OK) {
+           status = 1;
+         }
+       }
+     }
+   } catch (const std::exception &e) {
+     std::fprintf(stderr, "%s\n", e.what());
+     status = 1;
+   }
+
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+
+   return status != 0 ? 1 : 0;
+}
@@ -0,0 +1,338 @@
+/*   This file is part of ELPA.
+
+     The ELPA library was originally created by the ELPA consortium,
+     consisting of the following organizations:
+
+     - Max Planck Computing and Data Facility (MPCDF), formerly known as
+       Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+     - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+       Informatik,
+     - Technische Universität München, Lehrstuhl für Informatik mit
+       Schwerpunkt Wissenschaftliches Rechnen ,
+     - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+     - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+       Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+       and
+     - IBM Deutschland GmbH
+
+
+     More information can be found here:
+     http://elpa.mpcdf.mpg.de/
+
+     ELPA is free software: you can redistribute it and/or modify
+     it under the terms of the version 3 of the license of the
+     GNU Lesser General Public License as published by the Free
+     Software Foundation.
+
+     ELPA is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU Lesser General Public License for more details.
+
+     You should have received a copy of the GNU Lesser General Public License
+     along with ELPA.  If not, see <http://www.gnu.org/licenses/>
+
+     ELPA reflects a substantial effort on the part of the original
+     ELPA consortium, and we ask you to respect the spirit of the
+     license that we chose: i.e., please contribute any changes you
+     may have back to the original ELPA library distribution, and keep
+     any derivatives of ELPA under the same license that we chose for
+     the original distribution, the GNU Lesser General Public License.
+*/
+
+#include "config.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+#include <math.h>
+
+#include <elpa/elpa.h>
+#include <assert.h>
+
+#define assert_elpa_ok(x) assert(x == ELPA_OK)
+#ifdef HAVE_64BIT_INTEGER_SUPPORT
+#define TEST_C_INT_TYPE_PTR long int*
+#define C_INT_TYPE_PTR long int*
+#define TEST_C_INT_TYPE long int
+#define C_INT_TYPE long int
+#else
+#define TEST_C_INT_TYPE_PTR int*
+#define C_INT_TYPE_PTR int*
+#define TEST_C_INT_TYPE int
+#define C_INT_TYPE int
+#endif
+
+#include "test/shared/generated.h"
+
+/* Test of the asynchronous solver API (real double, ELPA 2stage):
+ * a solve overlapped with host work, a cancelled solve, a solve on the same
+ * handle after the cancellation and an asynchronous eigenvalue solve */
+
+static int check_eigenvectors(C_INT_TYPE na, C_INT_TYPE nev, C_INT_TYPE na_rows, C_INT_TYPE na_cols, double *as, double *z, double *ev,
+                              C_INT_TYPE *sc_desc, C_INT_TYPE nblk, C_INT_TYPE myid, C_INT_TYPE np_rows, C_INT_TYPE np_cols,
+                              C_INT_TYPE my_prow, C_INT_TYPE my_pcol) {
+   return check_correctness_evp_numeric_residuals_real_double_f(na, nev, na_rows, na_cols, as, z, ev,
+                              sc_desc, nblk, myid, np_rows, np_cols, my_prow, my_pcol);
+}
+
+int main(int argc, char** argv) {
+   /* matrix dimensions */
+   C_INT_TYPE na, nev, nblk;
+
+   /* mpi */
+   C_INT_TYPE myid, nprocs;
+   C_INT_TYPE na_cols, na_rows;
+   C_INT_TYPE np_cols, np_rows;
+   C_INT_TYPE my_prow, my_pcol;
+   C_INT_TYPE mpi_comm;
+
+   /* blacs */
+   C_INT_TYPE my_blacs_ctxt, sc_desc[9], info, blacs_ok;
+
+   /* The Matrix */
+   double *a, *as, *z;
+   double *ev, *ev_ref;
+
+   C_INT_TYPE status, i;
+   int error_elpa, flag;
+   long host_work;
+   double host_sum;
+
+   elpa_t handle;
+   elpa_request_t request;
+
+#ifdef WITH_MPI
+   int provided;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+   if (provided < MPI_THREAD_SERIALIZED) {
+     if (myid == 0) {
+       printf("MPI does not provide MPI_THREAD_SERIALIZED, skipping the test\n");
+     }
+     MPI_Finalize();
+     return 77;
+   }
+#else
+   nprocs = 1;
+   myid = 0;
+#endif
+
+#if defined(HAVE_64BIT_INTEGER_MPI_SUPPORT) || defined(HAVE_64BIT_INTEGER_MATH_SUPPORT) || defined(HAVE_64BIT_INTEGER_SUPPORT)
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+   return 77;
+#endif
+
+   if (argc == 4) {
+     na = atoi(argv[1]);
+     nev = atoi(argv[2]);
+     nblk = atoi(argv[3]);
+   } else {
+     na = 500;
+     nev = 250;
+     nblk = 16;
+   }
+
+   for (np_cols = (C_INT_TYPE) sqrt((double) nprocs); np_cols > 1; np_cols--) {
+     if (nprocs % np_cols == 0) {
+       break;
+     }
+   }
+
+   np_rows = nprocs/np_cols;
+
+#ifdef WITH_MPI
+   mpi_comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+#else
+   mpi_comm = 0;
+#endif
+   set_up_blacsgrid_f(mpi_comm, np_rows, np_cols, 'C', &my_blacs_ctxt, &my_prow, &my_pcol);
+   set_up_blacs_descriptor_f(na, nblk, my_prow, my_pcol, np_rows, np_cols, &na_rows, &na_cols, sc_desc, my_blacs_ctxt, &info, &blacs_ok);
+
+   if (blacs_ok == 0) {
+     if (myid == 0) {
+       printf("Setting up the blacsgrid failed. Aborting...");
+     }
+#ifdef WITH_MPI
+     MPI_Finalize();
+#endif
+     abort();
+   }
+
+   a      = (double *) calloc(na_rows*na_cols, sizeof(double));
+   z      = (double *) calloc(na_rows*na_cols, sizeof(double));
+   as     = (double *) calloc(na_rows*na_cols, sizeof(double));
+   ev     = (double *) calloc(na, sizeof(double));
+   ev_ref = (double *) calloc(na, sizeof(double));
+
+   prepare_matrix_random_real_double_f(na, myid, na_rows, na_cols, sc_desc, a, z, as, 0);
+
+   if (elpa_init(CURRENT_API_VERSION) != ELPA_OK) {
+     fprintf(stderr, "Error: ELPA API version not supported");
+     exit(1);
+   }
+
+   handle = elpa_allocate(&error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   elpa_set(handle, "na", (int) na, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "nev", (int) nev, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "local_nrows", (int) na_rows, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "local_ncols", (int) na_cols, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "nblk", (int) nblk, &error_elpa);
+   assert_elpa_ok(error_elpa);
+#ifdef WITH_MPI
+   elpa_set(handle, "mpi_comm_parent", (int) (MPI_Comm_c2f(MPI_COMM_WORLD)), &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "process_row", (int) my_prow, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "process_col", (int) my_pcol, &error_elpa);
+   assert_elpa_ok(error_elpa);
+#endif
+   assert_elpa_ok(elpa_setup(handle));
+
+   elpa_set(handle, "solver", ELPA_SOLVER_2STAGE, &error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   /* 1. solve in the background while the host keeps working */
+   elpa_eigenvectors_async(handle, a, ev, z, &request, &error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   host_work = 0;
+   host_sum = 0.0;
+   do {
+     for (i = 0; i < 1000; i++) {
+       host_sum += sin((double) i);
+     }
+     host_work++;
+     elpa_test(&request, &flag, &error_elpa);
+   } while (flag == 0);
+   assert_elpa_ok(error_elpa);
+   assert(request == ELPA_REQUEST_NULL);
+
+   if (myid == 0) {
+     printf("Host work done during the asynchronous solve: %ld units (%g)\n", host_work, host_sum);
+   }
+
+   status = check_eigenvectors(na, nev, na_rows, na_cols, as, z, ev, sc_desc, nblk, myid, np_rows, np_cols, my_prow, my_pcol);
+   if (status != 0) {
+     printf("The eigenvectors of the asynchronous solve are not correct!\n");
+   }
+   memcpy(ev_ref, ev, na*sizeof(double));
+
+   /* 2. a cancelled solve stops after one of its steps; the problem is large enough that
+    *    the cancellation always arrives before the first step is done */
+   {
+     C_INT_TYPE na_big, na_big_rows, na_big_cols, sc_desc_big[9];
+     double *a_big, *z_big, *as_big, *ev_big;
+     elpa_t handle_big;
+
+     na_big = na > 3000 ? na : 3000;
+     set_up_blacs_descriptor_f(na_big, nblk, my_prow, my_pcol, np_rows, np_cols, &na_big_rows, &na_big_cols, sc_desc_big,
+                               my_blacs_ctxt, &info, &blacs_ok);
+     assert(blacs_ok != 0);
+
+     a_big  = (double *) calloc(na_big_rows*na_big_cols, sizeof(double));
+     z_big  = (double *) calloc(na_big_rows*na_big_cols, sizeof(double));
+     as_big = (double *) calloc(na_big_rows*na_big_cols, sizeof(double));
+     ev_big = (double *) calloc(na_big, sizeof(double));
+     prepare_matrix_random_real_double_f(na_big, myid, na_big_rows, na_big_cols, sc_desc_big, a_big, z_big, as_big, 0);
+
+     handle_big = elpa_allocate(&error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_set(handle_big, "na", (int) na_big, &error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_set(handle_big, "nev", (int) na_big, &error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_set(handle_big, "local_nrows", (int) na_big_rows, &error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_set(handle_big, "local_ncols", (int) na_big_cols, &error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_set(handle_big, "nblk", (int) nblk, &error_elpa);
+     assert_elpa_ok(error_elpa);
+#ifdef WITH_MPI
+     elpa_set(handle_big, "mpi_comm_parent", (int) (MPI_Comm_c2f(MPI_COMM_WORLD)), &error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_set(handle_big, "process_row", (int) my_prow, &error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_set(handle_big, "process_col", (int) my_pcol, &error_elpa);
+     assert_elpa_ok(error_elpa);
+#endif
+     assert_elpa_ok(elpa_setup(handle_big));
+     elpa_set(handle_big, "solver", ELPA_SOLVER_2STAGE, &error_elpa);
+     assert_elpa_ok(error_elpa);
+
+     elpa_eigenvectors_async(handle_big, a_big, ev_big, z_big, &request, &error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_cancel(request, &error_elpa);
+     assert_elpa_ok(error_elpa);
+     elpa_wait(&request, &error_elpa);
+     assert(error_elpa == ELPA_ERROR_CANCELLED);
+     assert(request == ELPA_REQUEST_NULL);
+     if (myid == 0) {
+       printf("Cancelled solve returned: %s\n", elpa_strerr(error_elpa));
+     }
+
+     elpa_deallocate(handle_big, &error_elpa);
+     free(a_big);
+     free(z_big);
+     free(as_big);
+     free(ev_big);
+   }
+
+   /* 3. the handle can be used again after the cancellation */
+   memcpy(a, as, na_rows*na_cols*sizeof(double));
+   elpa_eigenvectors(handle, a, ev, z, &error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   if (status == 0) {
+     status = check_eigenvectors(na, nev, na_rows, na_cols, as, z, ev, sc_desc, nblk, myid, np_rows, np_cols, my_prow, my_pcol);
+     if (status != 0) {
+       printf("The eigenvectors after a cancelled solve are not correct!\n");
+     }
+   }
+
+   /* 4. asynchronous eigenvalues */
+   memcpy(a, as, na_rows*na_cols*sizeof(double));
+   elpa_eigenvalues_async(handle, a, ev, &request, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_wait(&request, &error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   for (i = 0; i < nev; i++) {
+     if (fabs(ev[i] - ev_ref[i]) > 1e-10 * fmax(1.0, fabs(ev_ref[i]))) {
+       printf("Eigenvalue %d of the asynchronous eigenvalue solve differs: %g %g\n", (int) i, ev[i], ev_ref[i]);
+       status = 1;
+       break;
+     }
+   }
+
+   elpa_deallocate(handle, &error_elpa);
+   elpa_uninit(&error_elpa);
+
+   if (status == 0 && myid == 0) {
+     printf("All ok!\n");
+   }
+
+   free(a);
+   free(z);
+   free(as);
+   free(ev);
+   free(ev_ref);
+
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+
+   return status;
+}
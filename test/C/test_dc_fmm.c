@@ -0,0 +1,240 @@
+/*   This file is part of ELPA.
+
+     The ELPA library was originally created by the ELPA consortium,
+     consisting of the following organizations:
+
+     - Max Planck Computing and Data Facility (MPCDF), formerly known as
+       Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+     - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+       Informatik,
+     - Technische Universität München, Lehrstuhl für Informatik mit
+       Schwerpunkt Wissenschaftliches Rechnen ,
+     - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+     - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+       Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+       and
+     - IBM Deutschland GmbH
+
+
+     More information can be found here:
+     http://elpa.mpcdf.mpg.de/
+
+     ELPA is free software: you can redistribute it and/or modify
+     it under the terms of the version 3 of the license of the
+     GNU Lesser General Public License as published by the Free
+     Software Foundation.
+
+     ELPA is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU Lesser General Public License for more details.
+
+     You should have received a copy of the GNU Lesser General Public License
+     along with ELPA.  If not, see <http://www.gnu.org/licenses/>
+
+     ELPA reflects a substantial effort on the part of the original
+     ELPA consortium, and we ask you to respect the spirit of the
+     license that we chose: i.e., please contribute any changes you
+     may have back to the original ELPA library distribution, and keep
+     any derivatives of ELPA under the same license that we chose for
+     the original distribution, the GNU Lesser General Public License.
+*/
+
+#include "config.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+#include <math.h>
+
+#include <elpa/elpa.h>
+#include <assert.h>
+
+#define assert_elpa_ok(x) assert(x == ELPA_OK)
+#ifdef HAVE_64BIT_INTEGER_SUPPORT
+#define TEST_C_INT_TYPE_PTR long int*
+#define C_INT_TYPE_PTR long int*
+#define TEST_C_INT_TYPE long int
+#define C_INT_TYPE long int
+#else
+#define TEST_C_INT_TYPE_PTR int*
+#define C_INT_TYPE_PTR int*
+#define TEST_C_INT_TYPE int
+#define C_INT_TYPE int
+#endif
+
+#include "test/shared/generated.h"
+#include "test/C/test_helpers.h"
+
+/* Test of the option "dc_fmm" (real double): the eigenvectors computed with the
+ * hierarchical eigenvector update in the divide and conquer solver must pass
+ * the residual and orthogonality checks, and the eigenvalues must agree with
+ * those of the dense update. nev < na, such that there are merges in the
+ * tridiagonal solver also on one process */
+
+static int solve(elpa_t handle, int fmm, C_INT_TYPE na_rows, C_INT_TYPE na_cols,
+                 double *as, double *a, double *ev, double *z) {
+   int error_elpa;
+
+   elpa_set(handle, "dc_fmm", fmm, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   return test_eigenvectors(handle, na_rows, na_cols, as, a, ev, z);
+}
+
+int main(int argc, char** argv) {
+   /* matrix dimensions */
+   C_INT_TYPE na, nev, nblk;
+
+   /* mpi */
+   C_INT_TYPE myid, nprocs;
+   C_INT_TYPE na_cols, na_rows;
+   C_INT_TYPE np_cols, np_rows;
+   C_INT_TYPE my_prow, my_pcol;
+   C_INT_TYPE mpi_comm;
+
+   /* blacs */
+   C_INT_TYPE my_blacs_ctxt, sc_desc[9], info, blacs_ok;
+
+   /* The Matrix */
+   double *a, *as, *z;
+   double *ev, *ev_ref;
+   double max_diff, ev_max;
+
+   C_INT_TYPE status;
+   int error_elpa, i;
+
+   elpa_t handle;
+
+#ifdef WITH_MPI
+#ifndef WITH_OPENMP_TRADITIONAL
+   MPI_Init(&argc, &argv);
+#else
+   int provided;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+#endif
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+#else
+   nprocs = 1;
+   myid = 0;
+#endif
+
+#if defined(HAVE_64BIT_INTEGER_MPI_SUPPORT) || defined(HAVE_64BIT_INTEGER_MATH_SUPPORT) || defined(HAVE_64BIT_INTEGER_SUPPORT)
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+   return 77;
+#endif
+
+   if (argc == 4) {
+     na = atoi(argv[1]);
+     nev = atoi(argv[2]);
+     nblk = atoi(argv[3]);
+   } else {
+     na = 1000;
+     nev = 500;
+     nblk = 16;
+   }
+
+#ifdef TEST_ONE_PROCESS_ROW
+   /* a single process row, such that the eigenvector blocks of merge_systems
+    * are passed around the ring of the process columns */
+   np_cols = nprocs;
+#else
+   for (np_cols = (C_INT_TYPE) sqrt((double) nprocs); np_cols > 1; np_cols--) {
+     if (nprocs % np_cols == 0) {
+       break;
+     }
+   }
+#endif
+
+   np_rows = nprocs/np_cols;
+
+#ifdef WITH_MPI
+   mpi_comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+#else
+   mpi_comm = 0;
+#endif
+   set_up_blacsgrid_f(mpi_comm, np_rows, np_cols, 'C', &my_blacs_ctxt, &my_prow, &my_pcol);
+   set_up_blacs_descriptor_f(na, nblk, my_prow, my_pcol, np_rows, np_cols, &na_rows, &na_cols, sc_desc, my_blacs_ctxt, &info, &blacs_ok);
+
+   if (blacs_ok == 0) {
+     if (myid == 0) {
+       printf("Setting up the blacsgrid failed. Aborting...");
+     }
+#ifdef WITH_MPI
+     MPI_Finalize();
+#endif
+     abort();
+   }
+
+   a      = (double *) calloc(na_rows*na_cols, sizeof(double));
+   z      = (double *) calloc(na_rows*na_cols, sizeof(double));
+   as     = (double *) calloc(na_rows*na_cols, sizeof(double));
+   ev     = (double *) calloc(na, sizeof(double));
+   ev_ref = (double *) calloc(na, sizeof(double));
+
+   prepare_matrix_random_real_double_f(na, myid, na_rows, na_cols, sc_desc, a, z, as, 0);
+
+   if (elpa_init(CURRENT_API_VERSION) != ELPA_OK) {
+     fprintf(stderr, "Error: ELPA API version not supported");
+     exit(1);
+   }
+
+   handle = test_allocate_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+   assert_elpa_ok(elpa_setup(handle));
+
+   elpa_set(handle, "solver", ELPA_SOLVER_1STAGE, &error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   /* all merges of the test size use the hierarchical update */
+   elpa_set(handle, "dc_fmm_min_size", 0, &error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   assert_elpa_ok(solve(handle, 0, na_rows, na_cols, as, a, ev_ref, z));
+   assert_elpa_ok(solve(handle, 1, na_rows, na_cols, as, a, ev, z));
+
+   status = check_correctness_evp_numeric_residuals_real_double_f(na, nev, na_rows, na_cols, as, z, ev,
+                          sc_desc, nblk, myid, np_rows, np_cols, my_prow, my_pcol);
+   if (status != 0 && myid == 0) {
+     printf("The eigenvectors computed with dc_fmm are not correct!\n");
+   }
+
+   max_diff = 0.0;
+   ev_max = 0.0;
+   for (i = 0; i < na; i++) {
+     max_diff = fmax(max_diff, fabs(ev[i] - ev_ref[i]));
+     ev_max = fmax(ev_max, fabs(ev_ref[i]));
+   }
+   if (myid == 0) {
+     printf("Maximal difference of the eigenvalues with dc_fmm: %e\n", max_diff);
+   }
+   if (max_diff > 1e-12 * ev_max) {
+     if (myid == 0) {
+       printf("The eigenvalues computed with dc_fmm differ!\n");
+     }
+     status = 1;
+   }
+
+   elpa_deallocate(handle, &error_elpa);
+   elpa_uninit(&error_elpa);
+
+   if (status == 0 && myid == 0) {
+     printf("All ok!\n");
+   }
+
+   free(a);
+   free(z);
+   free(as);
+   free(ev);
+   free(ev_ref);
+
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+
+   return status;
+}
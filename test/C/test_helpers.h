@@ -0,0 +1,90 @@
+/*   This file is part of ELPA.
+
+     The ELPA library was originally created by the ELPA consortium,
+     consisting of the following organizations:
+
+     - Max Planck Computing and Data Facility (MPCDF), formerly known as
+       Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+     - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+       Informatik,
+     - Technische Universität München, Lehrstuhl für Informatik mit
+       Schwerpunkt Wissenschaftliches Rechnen ,
+     - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+     - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+       Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+       and
+     - IBM Deutschland GmbH
+
+
+     More information can be found here:
+     http://elpa.mpcdf.mpg.de/
+
+     ELPA is free software: you can redistribute it and/or modify
+     it under the terms of the version 3 of the license of the
+     GNU Lesser General Public License as published by the Free
+     Software Foundation.
+
+     ELPA is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU Lesser General Public License for more details.
+
+     You should have received a copy of the GNU Lesser General Public License
+     along with ELPA.  If not, see <http://www.gnu.org/licenses/>
+
+     ELPA reflects a substantial effort on the part of the original
+     ELPA consortium, and we ask you to respect the spirit of the
+     license that we chose: i.e., please contribute any changes you
+     may have back to the original ELPA library distribution, and keep
+     any derivatives of ELPA under the same license that we chose for
+     the original distribution, the GNU Lesser General Public License.
+*/
+
+/* Helpers of the C tests of single options with a real double matrix.
+ *
+ * Include after <elpa/elpa.h>, <mpi.h> (with MPI), the definition of
+ * C_INT_TYPE and assert_elpa_ok */
+
+/* Allocates an ELPA object for the distributed matrix of the test and sets the
+ * matrix sizes and the process grid. Further options can be set before
+ * elpa_setup */
+static inline elpa_t test_allocate_handle(C_INT_TYPE na, C_INT_TYPE nev, C_INT_TYPE na_rows, C_INT_TYPE na_cols,
+                                          C_INT_TYPE nblk, C_INT_TYPE my_prow, C_INT_TYPE my_pcol) {
+   elpa_t handle;
+   int error_elpa;
+
+   handle = elpa_allocate(&error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   elpa_set(handle, "na", (int) na, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "nev", (int) nev, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "local_nrows", (int) na_rows, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "local_ncols", (int) na_cols, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "nblk", (int) nblk, &error_elpa);
+   assert_elpa_ok(error_elpa);
+#ifdef WITH_MPI
+   elpa_set(handle, "mpi_comm_parent", (int) (MPI_Comm_c2f(MPI_COMM_WORLD)), &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "process_row", (int) my_prow, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "process_col", (int) my_pcol, &error_elpa);
+   assert_elpa_ok(error_elpa);
+#endif
+   return handle;
+}
+
+/* Eigenvectors of the matrix as, which is kept: a is overwritten with a copy of
+ * as and z is cleared before the solve. Returns the error code of ELPA */
+static inline int test_eigenvectors(elpa_t handle, C_INT_TYPE na_rows, C_INT_TYPE na_cols,
+                                    double *as, double *a, double *ev, double *z) {
+   int error_elpa;
+
+   memcpy(a, as, na_rows*na_cols*sizeof(double));
+   memset(z, 0, na_rows*na_cols*sizeof(double));
+   elpa_eigenvectors(handle, a, ev, z, &error_elpa);
+   return error_elpa;
+}
@@ -0,0 +1,302 @@
+/*   This file is part of ELPA.
+
+     The ELPA library was originally created by the ELPA consortium,
+     consisting of the following organizations:
+
+     - Max Planck Computing and Data Facility (MPCDF), formerly known as
+       Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+     - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+       Informatik,
+     - Technische Universität München, Lehrstuhl für Informatik mit
+       Schwerpunkt Wissenschaftliches Rechnen ,
+     - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+     - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+       Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+       and
+     - IBM Deutschland GmbH
+
+
+     More information can be found here:
+     http://elpa.mpcdf.mpg.de/
+
+     ELPA is free software: you can redistribute it and/or modify
+     it under the terms of the version 3 of the license of the
+     GNU Lesser General Public License as published by the Free
+     Software Foundation.
+
+     ELPA is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU Lesser General Public License for more details.
+
+     You should have received a copy of the GNU Lesser General Public License
+     along with ELPA.  If not, see <http://www.gnu.org/licenses/>
+
+     ELPA reflects a substantial effort on the part of the original
+     ELPA consortium, and we ask you to respect the spirit of the
+     license that we chose: i.e., please contribute any changes you
+     may have back to the original ELPA library distribution, and keep
+     any derivatives of ELPA under the same license that we chose for
+     the original distribution, the GNU Lesser General Public License.
+*/
+#include "config.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+#include <math.h>
+
+#include <elpa/elpa.h>
+#include <assert.h>
+
+#define assert_elpa_ok(x) assert(x == ELPA_OK)
+#ifdef HAVE_64BIT_INTEGER_SUPPORT
+#define TEST_C_INT_TYPE_PTR long int*
+#define C_INT_TYPE_PTR long int*
+#define TEST_C_INT_TYPE long int
+#define C_INT_TYPE long int
+#else
+#define TEST_C_INT_TYPE_PTR int*
+#define C_INT_TYPE_PTR int*
+#define TEST_C_INT_TYPE int
+#define C_INT_TYPE int
+#endif
+
+#include "test/shared/generated.h"
+#include "test/C/test_helpers.h"
+
+/* Test of the file of the option "kernel_model" (real double): the first setup
+ * measures the kernels and stores the times in ELPA_KERNEL_MODEL_FILE, a second
+ * setup reads them back and leaves the file untouched, and a setup with a file
+ * which lacks some of the times measures and appends only those */
+
+static elpa_t new_handle(C_INT_TYPE na, C_INT_TYPE nev, C_INT_TYPE na_rows, C_INT_TYPE na_cols, C_INT_TYPE nblk,
+                         C_INT_TYPE my_prow, C_INT_TYPE my_pcol) {
+   elpa_t handle;
+   int error_elpa;
+
+   handle = test_allocate_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+   elpa_set(handle, "kernel_model", 1, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   assert_elpa_ok(elpa_setup(handle));
+
+   elpa_set(handle, "solver", ELPA_SOLVER_2STAGE, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   return handle;
+}
+
+/* the contents of the file, NULL terminated, and its number of lines */
+static char *read_file(const char *file_name, long *lines) {
+   char *contents;
+   FILE *file;
+   long size, i;
+
+   file = fopen(file_name, "rb");
+   assert(file != NULL);
+   fseek(file, 0, SEEK_END);
+   size = ftell(file);
+   fseek(file, 0, SEEK_SET);
+   contents = calloc(size + 1, 1);
+   assert(fread(contents, 1, size, file) == (size_t) size);
+   fclose(file);
+
+   *lines = 0;
+   for (i = 0; i < size; i++) {
+     if (contents[i] == '\n') {
+       (*lines)++;
+     }
+   }
+   return contents;
+}
+
+int main(int argc, char** argv) {
+   /* matrix dimensions */
+   C_INT_TYPE na, nev, nblk;
+
+   /* mpi */
+   C_INT_TYPE myid, nprocs;
+   C_INT_TYPE na_cols, na_rows;
+   C_INT_TYPE np_cols, np_rows;
+   C_INT_TYPE my_prow, my_pcol;
+   C_INT_TYPE mpi_comm;
+
+   /* blacs */
+   C_INT_TYPE my_blacs_ctxt, sc_desc[9], info, blacs_ok;
+
+   /* The Matrix */
+   double *a, *as, *z;
+   double *ev;
+
+   C_INT_TYPE status;
+   int error_elpa, fd;
+   char file_name[] = "/tmp/elpa_kernel_model_XXXXXX";
+   char *measured, *contents, *half;
+   long lines, lines_measured, i;
+   FILE *file;
+
+   elpa_t handle;
+
+#ifdef WITH_MPI
+   MPI_Init(&argc, &argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+#else
+   nprocs = 1;
+   myid = 0;
+#endif
+
+#if defined(HAVE_64BIT_INTEGER_MPI_SUPPORT) || defined(HAVE_64BIT_INTEGER_MATH_SUPPORT) || defined(HAVE_64BIT_INTEGER_SUPPORT)
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+   return 77;
+#endif
+
+   if (argc == 4) {
+     na = atoi(argv[1]);
+     nev = atoi(argv[2]);
+     nblk = atoi(argv[3]);
+   } else {
+     na = 200;
+     nev = 100;
+     nblk = 16;
+   }
+
+#ifdef TEST_ONE_PROCESS_ROW
+   /* a single process row and nev such that the first process column holds 2048
+      eigenvectors and the last one 64 less: the blocking_in_band_to_full chosen
+      from their local sizes differs, 2 against 1, and must be agreed on */
+   np_cols = nprocs;
+   nblk = 64;
+   na = nblk * (32 * np_cols - 1);
+   nev = na;
+#else
+   for (np_cols = (C_INT_TYPE) sqrt((double) nprocs); np_cols > 1; np_cols--) {
+     if (nprocs % np_cols == 0) {
+       break;
+     }
+   }
+#endif
+
+   np_rows = nprocs/np_cols;
+
+#ifdef WITH_MPI
+   mpi_comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+#else
+   mpi_comm = 0;
+#endif
+   set_up_blacsgrid_f(mpi_comm, np_rows, np_cols, 'C', &my_blacs_ctxt, &my_prow, &my_pcol);
+   set_up_blacs_descriptor_f(na, nblk, my_prow, my_pcol, np_rows, np_cols, &na_rows, &na_cols, sc_desc, my_blacs_ctxt, &info, &blacs_ok);
+
+   if (blacs_ok == 0) {
+     if (myid == 0) {
+       printf("Setting up the blacsgrid failed. Aborting...");
+     }
+#ifdef WITH_MPI
+     MPI_Finalize();
+#endif
+     abort();
+   }
+
+   a  = (double *) calloc(na_rows*na_cols, sizeof(double));
+   z  = (double *) calloc(na_rows*na_cols, sizeof(double));
+   as = (double *) calloc(na_rows*na_cols, sizeof(double));
+   ev = (double *) calloc(na, sizeof(double));
+
+   prepare_matrix_random_real_double_f(na, myid, na_rows, na_cols, sc_desc, a, z, as, 0);
+
+   /* only process 0 reads and writes the file, starting from an empty one */
+   if (myid == 0) {
+     fd = mkstemp(file_name);
+     assert(fd >= 0);
+     close(fd);
+     assert(setenv("ELPA_KERNEL_MODEL_FILE", file_name, 1) == 0);
+   }
+
+   if (elpa_init(CURRENT_API_VERSION) != ELPA_OK) {
+     fprintf(stderr, "Error: ELPA API version not supported");
+     exit(1);
+   }
+
+   status = 0;
+
+   /* 1. the first setup measures all kernels */
+   handle = new_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+   elpa_deallocate(handle, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   if (myid == 0) {
+     measured = read_file(file_name, &lines_measured);
+     if (lines_measured == 0) {
+       printf("The first setup did not store the kernel model in %s\n", file_name);
+       status = 1;
+     }
+   }
+
+   /* 2. the second setup reads all times from the file: it does not measure and write again */
+   handle = new_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+   elpa_deallocate(handle, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   if (myid == 0) {
+     contents = read_file(file_name, &lines);
+     if (strcmp(contents, measured) != 0) {
+       printf("The second setup measured the kernels again instead of reading %s\n", file_name);
+       status = 1;
+     }
+     free(contents);
+
+     /* keep only the first half of the times */
+     half = measured;
+     for (i = 0; i < lines_measured / 2; i++) {
+       half = strchr(half, '\n') + 1;
+     }
+     file = fopen(file_name, "wb");
+     assert(file != NULL);
+     assert(fwrite(measured, 1, half - measured, file) == (size_t) (half - measured));
+     fclose(file);
+   }
+
+   /* 3. a setup with an incomplete file measures and appends only the missing times */
+   handle = new_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+   if (myid == 0) {
+     contents = read_file(file_name, &lines);
+     if (strncmp(contents, measured, half - measured) != 0 || lines != lines_measured) {
+       printf("The setup with an incomplete kernel model wrote %ld instead of %ld lines\n", lines, lines_measured);
+       status = 1;
+     }
+     free(contents);
+     free(measured);
+     remove(file_name);
+   }
+
+   /* the solver with the kernel model read from the file */
+   elpa_eigenvectors(handle, a, ev, z, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   status |= check_correctness_evp_numeric_residuals_real_double_f(na, nev, na_rows, na_cols, as, z, ev,
+                              sc_desc, nblk, myid, np_rows, np_cols, my_prow, my_pcol);
+
+#ifdef WITH_MPI
+   MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+#endif
+
+   elpa_deallocate(handle, &error_elpa);
+   elpa_uninit(&error_elpa);
+
+   if (status == 0 && myid == 0) {
+     printf("All ok!\n");
+   }
+
+   free(a);
+   free(z);
+   free(as);
+   free(ev);
+
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+
+   return status;
+}
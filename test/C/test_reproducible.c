@@ -0,0 +1,256 @@
+/*   This file is part of ELPA.
+
+     The ELPA library was originally created by the ELPA consortium,
+     consisting of the following organizations:
+
+     - Max Planck Computing and Data Facility (MPCDF), formerly known as
+       Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+     - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+       Informatik,
+     - Technische Universität München, Lehrstuhl für Informatik mit
+       Schwerpunkt Wissenschaftliches Rechnen ,
+     - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+     - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+       Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+       and
+     - IBM Deutschland GmbH
+
+
+     More information can be found here:
+     http://elpa.mpcdf.mpg.de/
+
+     ELPA is free software: you can redistribute it and/or modify
+     it under the terms of the version 3 of the license of the
+     GNU Lesser General Public License as published by the Free
+     Software Foundation.
+
+     ELPA is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU Lesser General Public License for more details.
+
+     You should have received a copy of the GNU Lesser General Public License
+     along with ELPA.  If not, see <http://www.gnu.org/licenses/>
+
+     ELPA reflects a substantial effort on the part of the original
+     ELPA consortium, and we ask you to respect the spirit of the
+     license that we chose: i.e., please contribute any changes you
+     may have back to the original ELPA library distribution, and keep
+     any derivatives of ELPA under the same license that we chose for
+     the original distribution, the GNU Lesser General Public License.
+*/
+
+#include "config.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+#ifdef WITH_OPENMP_TRADITIONAL
+#include <omp.h>
+#endif
+#include <math.h>
+
+#include <elpa/elpa.h>
+#include <assert.h>
+
+#define assert_elpa_ok(x) assert(x == ELPA_OK)
+#ifdef HAVE_64BIT_INTEGER_SUPPORT
+#define TEST_C_INT_TYPE_PTR long int*
+#define C_INT_TYPE_PTR long int*
+#define TEST_C_INT_TYPE long int
+#define C_INT_TYPE long int
+#else
+#define TEST_C_INT_TYPE_PTR int*
+#define C_INT_TYPE_PTR int*
+#define TEST_C_INT_TYPE int
+#define C_INT_TYPE int
+#endif
+
+#include "test/shared/generated.h"
+#include "test/C/test_helpers.h"
+
+/* Test of the option "reproducible" (real double): the ELPA 1stage and 2stage
+ * solvers must give bitwise identical eigenvalues and eigenvectors with one
+ * and with all available OpenMP threads, and the same results if repeated */
+
+static int solve(elpa_t handle, int solver, int threads, C_INT_TYPE na_rows, C_INT_TYPE na_cols,
+                 double *as, double *a, double *ev, double *z) {
+   int error_elpa;
+
+   elpa_set(handle, "solver", solver, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_set(handle, "omp_threads", threads, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   return test_eigenvectors(handle, na_rows, na_cols, as, a, ev, z);
+}
+
+int main(int argc, char** argv) {
+   /* matrix dimensions */
+   C_INT_TYPE na, nev, nblk;
+
+   /* mpi */
+   C_INT_TYPE myid, nprocs;
+   C_INT_TYPE na_cols, na_rows;
+   C_INT_TYPE np_cols, np_rows;
+   C_INT_TYPE my_prow, my_pcol;
+   C_INT_TYPE mpi_comm;
+
+   /* blacs */
+   C_INT_TYPE my_blacs_ctxt, sc_desc[9], info, blacs_ok;
+
+   /* The Matrix */
+   double *a, *as, *z, *z_ref;
+   double *ev, *ev_ref;
+
+   C_INT_TYPE status;
+   int error_elpa, max_threads, s, r, differs;
+   const int solvers[2] = {ELPA_SOLVER_1STAGE, ELPA_SOLVER_2STAGE};
+
+   elpa_t handle;
+
+#ifdef WITH_MPI
+#ifndef WITH_OPENMP_TRADITIONAL
+   MPI_Init(&argc, &argv);
+#else
+   int provided;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+#endif
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+#else
+   nprocs = 1;
+   myid = 0;
+#endif
+
+#if defined(HAVE_64BIT_INTEGER_MPI_SUPPORT) || defined(HAVE_64BIT_INTEGER_MATH_SUPPORT) || defined(HAVE_64BIT_INTEGER_SUPPORT)
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+   return 77;
+#endif
+
+   if (argc == 4) {
+     na = atoi(argv[1]);
+     nev = atoi(argv[2]);
+     nblk = atoi(argv[3]);
+   } else {
+     na = 500;
+     nev = 250;
+     nblk = 16;
+   }
+
+#ifdef WITH_OPENMP_TRADITIONAL
+   max_threads = omp_get_max_threads();
+#else
+   max_threads = 1;
+#endif
+
+   for (np_cols = (C_INT_TYPE) sqrt((double) nprocs); np_cols > 1; np_cols--) {
+     if (nprocs % np_cols == 0) {
+       break;
+     }
+   }
+
+   np_rows = nprocs/np_cols;
+
+#ifdef WITH_MPI
+   mpi_comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+#else
+   mpi_comm = 0;
+#endif
+   set_up_blacsgrid_f(mpi_comm, np_rows, np_cols, 'C', &my_blacs_ctxt, &my_prow, &my_pcol);
+   set_up_blacs_descriptor_f(na, nblk, my_prow, my_pcol, np_rows, np_cols, &na_rows, &na_cols, sc_desc, my_blacs_ctxt, &info, &blacs_ok);
+
+   if (blacs_ok == 0) {
+     if (myid == 0) {
+       printf("Setting up the blacsgrid failed. Aborting...");
+     }
+#ifdef WITH_MPI
+     MPI_Finalize();
+#endif
+     abort();
+   }
+
+   a      = (double *) calloc(na_rows*na_cols, sizeof(double));
+   z      = (double *) calloc(na_rows*na_cols, sizeof(double));
+   z_ref  = (double *) calloc(na_rows*na_cols, sizeof(double));
+   as     = (double *) calloc(na_rows*na_cols, sizeof(double));
+   ev     = (double *) calloc(na, sizeof(double));
+   ev_ref = (double *) calloc(na, sizeof(double));
+
+   prepare_matrix_random_real_double_f(na, myid, na_rows, na_cols, sc_desc, a, z, as, 0);
+
+   if (elpa_init(CURRENT_API_VERSION) != ELPA_OK) {
+     fprintf(stderr, "Error: ELPA API version not supported");
+     exit(1);
+   }
+
+   handle = test_allocate_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+   assert_elpa_ok(elpa_setup(handle));
+
+   elpa_set(handle, "reproducible", 1, &error_elpa);
+   assert_elpa_ok(error_elpa);
+
+   /* the non-blocking collectives and the kernel model are excluded in the reproducible mode */
+   elpa_set(handle, "nbc_row_global_gather", 1, &error_elpa);
+   assert(error_elpa != ELPA_OK);
+   elpa_set(handle, "kernel_model", 1, &error_elpa);
+   assert(error_elpa != ELPA_OK);
+
+   status = 0;
+   for (s = 0; s < 2; s++) {
+     assert_elpa_ok(solve(handle, solvers[s], 1, na_rows, na_cols, as, a, ev_ref, z_ref));
+
+     if (status == 0) {
+       status = check_correctness_evp_numeric_residuals_real_double_f(na, nev, na_rows, na_cols, as, z_ref, ev_ref,
+                              sc_desc, nblk, myid, np_rows, np_cols, my_prow, my_pcol);
+       if (status != 0) {
+         printf("The eigenvectors of the reproducible solve are not correct!\n");
+       }
+     }
+
+     /* again with one thread, and with all threads */
+     for (r = 0; r < 2; r++) {
+       assert_elpa_ok(solve(handle, solvers[s], r == 0 ? 1 : max_threads, na_rows, na_cols, as, a, ev, z));
+
+       differs = memcmp(ev, ev_ref, na*sizeof(double)) != 0 ||
+                 memcmp(z, z_ref, na_rows*na_cols*sizeof(double)) != 0;
+#ifdef WITH_MPI
+       MPI_Allreduce(MPI_IN_PLACE, &differs, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+#endif
+       if (differs) {
+         if (myid == 0) {
+           printf("ELPA %dstage with %d threads is not bitwise identical to 1 thread!\n", s+1, r == 0 ? 1 : max_threads);
+         }
+         status = 1;
+       }
+     }
+   }
+
+   if (myid == 0) {
+     printf("Compared ELPA 1stage and 2stage with 1 and %d OpenMP threads\n", max_threads);
+   }
+
+   elpa_deallocate(handle, &error_elpa);
+   elpa_uninit(&error_elpa);
+
+   if (status == 0 && myid == 0) {
+     printf("All ok!\n");
+   }
+
+   free(a);
+   free(z);
+   free(z_ref);
+   free(as);
+   free(ev);
+   free(ev_ref);
+
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+
+   return status;
+}
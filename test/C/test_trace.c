@@ -0,0 +1,273 @@
+/*   This file is part of ELPA.
+
+     The ELPA library was originally created by the ELPA consortium,
+     consisting of the following organizations:
+
+     - Max Planck Computing and Data Facility (MPCDF), formerly known as
+       Rechenzentrum Garching der Max-Planck-Gesellschaft (RZG),
+     - Bergische Universität Wuppertal, Lehrstuhl für angewandte
+       Informatik,
+     - Technische Universität München, Lehrstuhl für Informatik mit
+       Schwerpunkt Wissenschaftliches Rechnen ,
+     - Fritz-Haber-Institut, Berlin, Abt. Theorie,
+     - Max-Plack-Institut für Mathematik in den Naturwissenschaften,
+       Leipzig, Abt. Komplexe Strukutren in Biologie und Kognition,
+       and
+     - IBM Deutschland GmbH
+
+
+     More information can be found here:
+     http://elpa.mpcdf.mpg.de/
+
+     ELPA is free software: you can redistribute it and/or modify
+     it under the terms of the version 3 of the license of the
+     GNU Lesser General Public License as published by the Free
+     Software Foundation.
+
+     ELPA is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU Lesser General Public License for more details.
+
+     You should have received a copy of the GNU Lesser General Public License
+     along with ELPA.  If not, see <http://www.gnu.org/licenses/>
+
+     ELPA reflects a substantial effort on the part of the original
+     ELPA consortium, and we ask you to respect the spirit of the
+     license that we chose: i.e., please contribute any changes you
+     may have back to the original ELPA library distribution, and keep
+     any derivatives of ELPA under the same license that we chose for
+     the original distribution, the GNU Lesser General Public License.
+*/
+
+
+#include "config.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+#include <math.h>
+
+#include <elpa/elpa.h>
+#include <assert.h>
+
+#define assert_elpa_ok(x) assert(x == ELPA_OK)
+#ifdef HAVE_64BIT_INTEGER_SUPPORT
+#define TEST_C_INT_TYPE_PTR long int*
+#define C_INT_TYPE_PTR long int*
+#define TEST_C_INT_TYPE long int
+#define C_INT_TYPE long int
+#else
+#define TEST_C_INT_TYPE_PTR int*
+#define C_INT_TYPE_PTR int*
+#define TEST_C_INT_TYPE int
+#define C_INT_TYPE int
+#endif
+
+#include "test/shared/generated.h"
+#include "test/C/test_helpers.h"
+
+/* Test of the option "trace" (real double): two handles record their regions
+ * in separate timelines. The exported JSON of each handle has to contain its own
+ * regions and none of the other handle, and writing the trace of one handle
+ * must not discard the regions of the other one */
+
+static elpa_t new_handle(C_INT_TYPE na, C_INT_TYPE nev, C_INT_TYPE na_rows, C_INT_TYPE na_cols, C_INT_TYPE nblk,
+                         C_INT_TYPE my_prow, C_INT_TYPE my_pcol) {
+   elpa_t handle;
+   int error_elpa;
+
+   handle = test_allocate_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+   elpa_set(handle, "trace", 1, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   assert_elpa_ok(elpa_setup(handle));
+
+   elpa_set(handle, "solver", ELPA_SOLVER_1STAGE, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   return handle;
+}
+
+/* writes the trace of handle and checks on process 0, that it contains the regions
+ * expected1 and expected2 and no region unexpected (NULL: no check) */
+static int check_trace(elpa_t handle, const char *file_name, int myid, const char *expected1,
+                       const char *expected2, const char *unexpected) {
+   const char *expected[2] = {expected1, expected2};
+   char pattern[128], *json;
+   FILE *file;
+   long size;
+   int error_elpa, i, status = 0;
+
+   elpa_write_trace(handle, file_name, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   if (myid != 0) {
+     return 0;
+   }
+
+   file = fopen(file_name, "rb");
+   assert(file != NULL);
+   fseek(file, 0, SEEK_END);
+   size = ftell(file);
+   fseek(file, 0, SEEK_SET);
+   json = calloc(size + 1, 1);
+   assert(fread(json, 1, size, file) == (size_t) size);
+   fclose(file);
+   remove(file_name);
+
+   if (strncmp(json, "{\"traceEvents\":[", 16) != 0 || strstr(json, "\"displayTimeUnit\":\"ms\"}") == NULL) {
+     printf("%s is not a trace event file\n", file_name);
+     status = 1;
+   }
+   for (i = 0; i < 2; i++) {
+     if (expected[i] == NULL) {
+       continue;
+     }
+     snprintf(pattern, sizeof(pattern), "{\"name\":\"%s\",\"cat\":\"elpa\",\"ph\":\"X\"", expected[i]);
+     if (strstr(json, pattern) == NULL) {
+       printf("%s does not contain the region %s\n", file_name, expected[i]);
+       status = 1;
+     }
+   }
+   if (unexpected != NULL) {
+     snprintf(pattern, sizeof(pattern), "{\"name\":\"%s", unexpected);
+     if (strstr(json, pattern) != NULL) {
+       printf("%s contains the region %s of an other handle or of an earlier call\n", file_name, unexpected);
+       status = 1;
+     }
+   }
+   free(json);
+   return status;
+}
+
+int main(int argc, char** argv) {
+   /* matrix dimensions */
+   C_INT_TYPE na, nev, nblk;
+
+   /* mpi */
+   C_INT_TYPE myid, nprocs;
+   C_INT_TYPE na_cols, na_rows;
+   C_INT_TYPE np_cols, np_rows;
+   C_INT_TYPE my_prow, my_pcol;
+   C_INT_TYPE mpi_comm;
+
+   /* blacs */
+   C_INT_TYPE my_blacs_ctxt, sc_desc[9], info, blacs_ok;
+
+   /* The Matrix */
+   double *a, *as, *z;
+   double *ev;
+
+   C_INT_TYPE status;
+   int error_elpa;
+
+   elpa_t handle1, handle2;
+
+#ifdef WITH_MPI
+   MPI_Init(&argc, &argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+#else
+   nprocs = 1;
+   myid = 0;
+#endif
+
+#if defined(HAVE_64BIT_INTEGER_MPI_SUPPORT) || defined(HAVE_64BIT_INTEGER_MATH_SUPPORT) || defined(HAVE_64BIT_INTEGER_SUPPORT)
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+   return 77;
+#endif
+
+   if (argc == 4) {
+     na = atoi(argv[1]);
+     nev = atoi(argv[2]);
+     nblk = atoi(argv[3]);
+   } else {
+     na = 200;
+     nev = 100;
+     nblk = 16;
+   }
+
+   for (np_cols = (C_INT_TYPE) sqrt((double) nprocs); np_cols > 1; np_cols--) {
+     if (nprocs % np_cols == 0) {
+       break;
+     }
+   }
+
+   np_rows = nprocs/np_cols;
+
+#ifdef WITH_MPI
+   mpi_comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+#else
+   mpi_comm = 0;
+#endif
+   set_up_blacsgrid_f(mpi_comm, np_rows, np_cols, 'C', &my_blacs_ctxt, &my_prow, &my_pcol);
+   set_up_blacs_descriptor_f(na, nblk, my_prow, my_pcol, np_rows, np_cols, &na_rows, &na_cols, sc_desc, my_blacs_ctxt, &info, &blacs_ok);
+
+   if (blacs_ok == 0) {
+     if (myid == 0) {
+       printf("Setting up the blacsgrid failed. Aborting...");
+     }
+#ifdef WITH_MPI
+     MPI_Finalize();
+#endif
+     abort();
+   }
+
+   a  = (double *) calloc(na_rows*na_cols, sizeof(double));
+   z  = (double *) calloc(na_rows*na_cols, sizeof(double));
+   as = (double *) calloc(na_rows*na_cols, sizeof(double));
+   ev = (double *) calloc(na, sizeof(double));
+
+   prepare_matrix_random_real_double_f(na, myid, na_rows, na_cols, sc_desc, a, z, as, 0);
+
+   if (elpa_init(CURRENT_API_VERSION) != ELPA_OK) {
+     fprintf(stderr, "Error: ELPA API version not supported");
+     exit(1);
+   }
+
+   handle1 = new_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+   handle2 = new_handle(na, nev, na_rows, na_cols, nblk, my_prow, my_pcol);
+
+   /* regions of both handles, only handle1 solves */
+   elpa_timer_start(handle1, "region_one");
+   elpa_eigenvectors(handle1, a, ev, z, &error_elpa);
+   assert_elpa_ok(error_elpa);
+   elpa_timer_stop(handle1, "region_one");
+
+   elpa_timer_start(handle2, "region_two");
+   elpa_timer_stop(handle2, "region_two");
+
+   status = 0;
+   status |= check_trace(handle1, "validate_trace_one.json", myid, "region_one", "elpa_solve_evp_real_1stage_double",
+                         "region_two");
+   /* the trace of handle2 is still complete after the one of handle1 was written */
+   status |= check_trace(handle2, "validate_trace_two.json", myid, "region_two", NULL, "elpa_solve_evp");
+   /* and discarded after it was written */
+   status |= check_trace(handle2, "validate_trace_two.json", myid, NULL, NULL, "region_two");
+
+#ifdef WITH_MPI
+   MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+#endif
+
+   elpa_deallocate(handle1, &error_elpa);
+   elpa_deallocate(handle2, &error_elpa);
+   elpa_uninit(&error_elpa);
+
+   if (status == 0 && myid == 0) {
+     printf("All ok!\n");
+   }
+
+   free(a);
+   free(z);
+   free(as);
+   free(ev);
+
+#ifdef WITH_MPI
+   MPI_Finalize();
+#endif
+
+   return status;
+}